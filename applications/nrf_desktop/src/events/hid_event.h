@@ -34,6 +34,7 @@ struct hid_report_event {
 
 	const void *source; /**< Id of the report source. */
 	const void *subscriber; /**< Id of the report subscriber. */
+	uint32_t timestamp; /**< Time of the oldest input in the report [cycles]. */
 	struct event_dyndata dyndata; /**< Report data. The first byte is a report id. */
 };
 
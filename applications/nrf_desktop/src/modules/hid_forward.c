@@ -36,6 +36,14 @@ LOG_MODULE_REGISTER(MODULE, CONFIG_DESKTOP_HID_FORWARD_LOG_LEVEL);
 #define OUTPUT_REPORT_DATA_MAX_LEN \
 	(IS_ENABLED(CONFIG_DESKTOP_HID_REPORT_KEYBOARD_SUPPORT)?(REPORT_SIZE_KEYBOARD_LEDS):(0))
 
+/* A peripheral holds up to MAX_ENQUEUED_ITEMS of every input report. Reports
+ * migrated to the subscriber on disconnection are taken back by the next
+ * registered peripheral, so the total never exceeds the amount that all
+ * peripherals can hold.
+ */
+#define ENQUEUED_ITEMS_POOL_SIZE \
+	(CONFIG_BT_MAX_CONN * ARRAY_SIZE(input_reports) * MAX_ENQUEUED_ITEMS)
+
 BUILD_ASSERT(CFG_CHAN_MAX_RSP_POLL_CNT <= UCHAR_MAX);
 
 struct enqueued_report {
@@ -58,10 +66,17 @@ struct report_data {
 	uint8_t data[OUTPUT_REPORT_DATA_MAX_LEN];
 } __packed;
 
+struct queue_stats {
+	uint32_t forwarded;
+	uint32_t enqueued;
+	uint32_t dropped;
+};
+
 struct subscriber {
 	const void *id;
 	uint32_t enabled_reports_bm;
 	struct enqueued_reports enqueued_reports;
+	struct queue_stats stats;
 	struct report_data out_reports[ARRAY_SIZE(output_reports)];
 	uint32_t saved_out_reports_bm;
 
@@ -87,6 +102,10 @@ static bt_addr_le_t peripheral_address[CONFIG_BT_MAX_PAIRED];
 static struct hids_peripheral peripherals[CONFIG_BT_MAX_CONN];
 static bool suspended;
 
+static K_MEM_SLAB_DEFINE(enqueued_items, sizeof(struct enqueued_report),
+			 ENQUEUED_ITEMS_POOL_SIZE, __alignof__(struct enqueued_report));
+static uint32_t enqueued_items_peak;
+
 
 static void hogp_out_rep_write_cb(struct bt_hogp *hogp, struct bt_hogp_rep_info *rep, uint8_t err);
 static int send_hid_out_report(struct bt_hogp *hogp, const uint8_t *data, size_t size);
@@ -265,7 +284,7 @@ static void drop_enqueued_reports(struct enqueued_reports *enqueued_reports,
 		item = get_enqueued_report(enqueued_reports, irep_idx);
 
 		app_event_manager_free(item->report);
-		k_free(item);
+		k_mem_slab_free(&enqueued_items, (void **)&item);
 	}
 }
 
@@ -344,7 +363,8 @@ static void migrate_enqueued_reports(struct enqueued_reports *dst_reports,
 
 static void enqueue_hid_report(struct enqueued_reports *enqueued_reports,
 			       size_t irep_idx,
-			       struct hid_report_event *report)
+			       struct hid_report_event *report,
+			       struct queue_stats *stats)
 {
 	__ASSERT_NO_MSG(irep_idx < ARRAY_SIZE(enqueued_reports->reports));
 
@@ -353,21 +373,29 @@ static void enqueue_hid_report(struct enqueued_reports *enqueued_reports,
 	struct enqueued_report *item;
 
 	if (reports->count < MAX_ENQUEUED_ITEMS) {
-		item = k_malloc(sizeof(*item));
+		if (k_mem_slab_alloc(&enqueued_items, (void **)&item, K_NO_WAIT)) {
+			item = NULL;
+		}
 	} else {
 		LOG_WRN("Enqueue dropped the oldest report");
 		item = get_enqueued_report(enqueued_reports, irep_idx);
 		app_event_manager_free(item->report);
+		stats->dropped++;
 	}
 
 	if (!item) {
 		LOG_ERR("Dropped HID report");
+		app_event_manager_free(report);
+		stats->dropped++;
 		/* Should never happen. */
 		__ASSERT_NO_MSG(false);
 	} else {
 		item->report = report;
 		sys_slist_append(&reports->list, &item->node);
 		reports->count++;
+		stats->enqueued++;
+		enqueued_items_peak = MAX(enqueued_items_peak,
+					  k_mem_slab_num_used_get(&enqueued_items));
 	}
 }
 
@@ -403,11 +431,17 @@ static void forward_hid_report(struct hids_peripheral *per, uint8_t report_id,
 
 	report->source = per;
 	report->subscriber = sub->id;
+	report->timestamp = k_cycle_get_32();
 
-	/* Forward report as is adding report id on the front. */
+	/* Forward report as is adding report id on the front. The notification
+	 * data is owned by the Bluetooth stack, so this is the only copy made on
+	 * the way to the subscriber. Enqueued reports are passed by reference.
+	 */
 	report->dyndata.data[0] = report_id;
 	memcpy(&report->dyndata.data[1], data, size);
 
+	sub->stats.forwarded++;
+
 	if (!sub->busy) {
 		__ASSERT_NO_MSG(!is_report_enqueued(&per->enqueued_reports, irep_idx));
 
@@ -415,7 +449,7 @@ static void forward_hid_report(struct hids_peripheral *per, uint8_t report_id,
 		per->enqueued_reports.last_idx = irep_idx;
 		sub->busy = true;
 	} else {
-		enqueue_hid_report(&per->enqueued_reports, irep_idx, report);
+		enqueue_hid_report(&per->enqueued_reports, irep_idx, report, &sub->stats);
 	}
 }
 
@@ -952,10 +986,25 @@ static void forward_empty_hid_report(struct hids_peripheral *per,
 	forward_hid_report(per, report_id, empty_data, size);
 }
 
+static void log_queue_stats(const struct subscriber *sub)
+{
+	if (!IS_ENABLED(CONFIG_DESKTOP_HID_FORWARD_QUEUE_STATS)) {
+		return;
+	}
+
+	LOG_INF("Subscriber %p: forwarded %" PRIu32 ", enqueued %" PRIu32
+		", dropped %" PRIu32, sub->id, sub->stats.forwarded,
+		sub->stats.enqueued, sub->stats.dropped);
+	LOG_INF("Enqueued reports pool peak usage %" PRIu32 "/%zu",
+		enqueued_items_peak, (size_t)ENQUEUED_ITEMS_POOL_SIZE);
+}
+
 static void disconnect_peripheral(struct hids_peripheral *per)
 {
 	LOG_INF("Peripheral %p disconnected", (void *)per);
 
+	log_queue_stats(get_subscriber(per));
+
 	struct bt_hogp_rep_info *rep;
 	uint8_t report_id;
 
@@ -1195,7 +1244,7 @@ static void send_enqueued_report(struct subscriber *sub)
 	if (item) {
 		APP_EVENT_SUBMIT(item->report);
 
-		k_free(item);
+		k_mem_slab_free(&enqueued_items, (void **)&item);
 
 		sub->busy = true;
 	}
@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <inttypes.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+
+#include "hid_event.h"
+#include "config_event.h"
+
+#define MODULE hid_latency
+#include <caf/events/module_state_event.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(MODULE, CONFIG_DESKTOP_HID_LATENCY_LOG_LEVEL);
+
+/* Number of reports in flight tracked for a subscriber and report ID. */
+#define TRACK_DEPTH		4
+
+/* Histogram buckets are spaced logarithmically, with four buckets per
+ * power of two. The reported percentiles are the upper bounds of the
+ * buckets, so the error is below 25%.
+ */
+#define SUB_BUCKET_BITS		2
+#define SUB_BUCKET_COUNT	BIT(SUB_BUCKET_BITS)
+#define LATENCY_MAX_BITS	20
+#define LATENCY_MAX_US		(BIT(LATENCY_MAX_BITS) - 1)
+#define BUCKET_COUNT		((LATENCY_MAX_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT)
+
+enum stage {
+	STAGE_DISPATCH,
+	STAGE_TRANSMIT,
+
+	STAGE_COUNT
+};
+
+enum hid_latency_opt {
+	HID_LATENCY_OPT_DISPATCH,
+	HID_LATENCY_OPT_TRANSMIT,
+	HID_LATENCY_OPT_RESET,
+
+	HID_LATENCY_OPT_COUNT
+};
+
+static const char * const opt_descr[] = {
+	[HID_LATENCY_OPT_DISPATCH] = "dispatch",
+	[HID_LATENCY_OPT_TRANSMIT] = "transmit",
+	[HID_LATENCY_OPT_RESET] = "reset",
+};
+
+/**@brief Latency histogram of a single stage. */
+struct latency_hist {
+	uint32_t count;
+	uint32_t max_us;
+	uint16_t bucket[BUCKET_COUNT];
+};
+
+/**@brief Timestamps of reports in flight for a subscriber and report ID. */
+struct report_track {
+	const void *subscriber;
+	uint8_t report_id;
+	uint8_t head;
+	uint8_t cnt;
+	uint32_t timestamp[TRACK_DEPTH];
+};
+
+/* Fetched data: sample count, median, 99th percentile and maximum [us]. */
+BUILD_ASSERT(4 * sizeof(uint32_t) <= CONFIG_CHANNEL_FETCHED_DATA_MAX_SIZE);
+
+static struct latency_hist hist[STAGE_COUNT];
+static struct report_track tracks[CONFIG_DESKTOP_HID_LATENCY_TRACK_COUNT];
+
+
+static size_t bucket_idx(uint32_t us)
+{
+	if (us < SUB_BUCKET_COUNT) {
+		return us;
+	}
+
+	uint32_t exp = 31 - __builtin_clz(us);
+	uint32_t sub = (us >> (exp - SUB_BUCKET_BITS)) & (SUB_BUCKET_COUNT - 1);
+
+	return (exp - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT + sub;
+}
+
+static uint32_t bucket_upper_bound(size_t idx)
+{
+	if (idx < SUB_BUCKET_COUNT) {
+		return idx;
+	}
+
+	uint32_t exp = idx / SUB_BUCKET_COUNT + SUB_BUCKET_BITS - 1;
+	uint32_t sub = idx % SUB_BUCKET_COUNT;
+
+	return ((SUB_BUCKET_COUNT + sub + 1) << (exp - SUB_BUCKET_BITS)) - 1;
+}
+
+static void latency_record(enum stage stage, uint32_t cycles)
+{
+	struct latency_hist *h = &hist[stage];
+	uint32_t us = k_cyc_to_us_floor32(cycles);
+	size_t idx = bucket_idx(MIN(us, LATENCY_MAX_US));
+
+	__ASSERT_NO_MSG(idx < ARRAY_SIZE(h->bucket));
+
+	if (h->bucket[idx] == UINT16_MAX) {
+		/* Halve all buckets to keep the distribution. */
+		for (size_t i = 0; i < ARRAY_SIZE(h->bucket); i++) {
+			h->bucket[i] /= 2;
+		}
+	}
+
+	h->bucket[idx]++;
+	h->count++;
+	h->max_us = MAX(h->max_us, us);
+}
+
+static uint32_t latency_percentile(const struct latency_hist *h, uint32_t permille)
+{
+	uint32_t total = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(h->bucket); i++) {
+		total += h->bucket[i];
+	}
+
+	uint32_t target = DIV_ROUND_UP((uint64_t)total * permille, 1000);
+	uint32_t sum = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(h->bucket); i++) {
+		sum += h->bucket[i];
+		if ((sum > 0) && (sum >= target)) {
+			return MIN(bucket_upper_bound(i), h->max_us);
+		}
+	}
+
+	return 0;
+}
+
+static struct report_track *get_track(const void *subscriber, uint8_t report_id, bool create)
+{
+	struct report_track *free_track = NULL;
+
+	for (size_t i = 0; i < ARRAY_SIZE(tracks); i++) {
+		struct report_track *track = &tracks[i];
+
+		if ((track->subscriber == subscriber) && (track->report_id == report_id)) {
+			return track;
+		}
+
+		if (!track->subscriber && !free_track) {
+			free_track = track;
+		}
+	}
+
+	if (create && free_track) {
+		free_track->subscriber = subscriber;
+		free_track->report_id = report_id;
+		free_track->head = 0;
+		free_track->cnt = 0;
+	} else if (create) {
+		LOG_DBG("No free report track");
+	}
+
+	return create ? free_track : NULL;
+}
+
+static void track_push(struct report_track *track, uint32_t timestamp)
+{
+	if (track->cnt == TRACK_DEPTH) {
+		/* Should not happen, transports keep fewer reports in flight. */
+		LOG_DBG("Report track overflow");
+		track->head = (track->head + 1) % TRACK_DEPTH;
+		track->cnt--;
+	}
+
+	track->timestamp[(track->head + track->cnt) % TRACK_DEPTH] = timestamp;
+	track->cnt++;
+}
+
+static bool handle_hid_report_event(const struct hid_report_event *event)
+{
+	/* Ignore HID output reports. */
+	if (!event->subscriber) {
+		return false;
+	}
+
+	uint32_t now = k_cycle_get_32();
+	uint8_t report_id = event->dyndata.data[0];
+	struct report_track *track = get_track(event->subscriber, report_id, true);
+
+	latency_record(STAGE_DISPATCH, now - event->timestamp);
+
+	if (track) {
+		track_push(track, event->timestamp);
+	}
+
+	return false;
+}
+
+static bool handle_hid_report_sent_event(const struct hid_report_sent_event *event)
+{
+	struct report_track *track = get_track(event->subscriber, event->report_id, false);
+
+	if (!track || (track->cnt == 0)) {
+		return false;
+	}
+
+	uint32_t timestamp = track->timestamp[track->head];
+
+	track->head = (track->head + 1) % TRACK_DEPTH;
+	track->cnt--;
+
+	if (!event->error) {
+		latency_record(STAGE_TRANSMIT, k_cycle_get_32() - timestamp);
+	}
+
+	return false;
+}
+
+static bool handle_hid_report_subscription_event(
+		const struct hid_report_subscription_event *event)
+{
+	if (!event->enabled) {
+		struct report_track *track = get_track(event->subscriber, event->report_id,
+						       false);
+
+		if (track) {
+			memset(track, 0, sizeof(*track));
+		}
+	}
+
+	return false;
+}
+
+static void config_set(const uint8_t opt_id, const uint8_t *data, const size_t size)
+{
+	switch (opt_id) {
+	case HID_LATENCY_OPT_RESET:
+		memset(hist, 0, sizeof(hist));
+		LOG_INF("Latency statistics reset");
+		break;
+
+	default:
+		LOG_WRN("Unsupported set opt_id: %" PRIu8, opt_id);
+		break;
+	}
+}
+
+static void config_fetch(const uint8_t opt_id, uint8_t *data, size_t *size)
+{
+	const struct latency_hist *h;
+
+	switch (opt_id) {
+	case HID_LATENCY_OPT_DISPATCH:
+		h = &hist[STAGE_DISPATCH];
+		break;
+
+	case HID_LATENCY_OPT_TRANSMIT:
+		h = &hist[STAGE_TRANSMIT];
+		break;
+
+	default:
+		LOG_WRN("Unsupported fetch opt_id: %" PRIu8, opt_id);
+		return;
+	}
+
+	sys_put_le32(h->count, &data[0]);
+	sys_put_le32(latency_percentile(h, 500), &data[4]);
+	sys_put_le32(latency_percentile(h, 990), &data[8]);
+	sys_put_le32(h->max_us, &data[12]);
+	*size = 4 * sizeof(uint32_t);
+}
+
+static bool app_event_handler(const struct app_event_header *aeh)
+{
+	if (is_hid_report_event(aeh)) {
+		return handle_hid_report_event(cast_hid_report_event(aeh));
+	}
+
+	if (is_hid_report_sent_event(aeh)) {
+		return handle_hid_report_sent_event(cast_hid_report_sent_event(aeh));
+	}
+
+	if (is_hid_report_subscription_event(aeh)) {
+		return handle_hid_report_subscription_event(
+				cast_hid_report_subscription_event(aeh));
+	}
+
+	if (is_module_state_event(aeh)) {
+		const struct module_state_event *event = cast_module_state_event(aeh);
+
+		if (check_state(event, MODULE_ID(main), MODULE_STATE_READY)) {
+			module_set_state(MODULE_STATE_READY);
+		}
+
+		return false;
+	}
+
+	GEN_CONFIG_EVENT_HANDLERS(STRINGIFY(MODULE), opt_descr, config_set,
+				  config_fetch);
+
+	/* If event is unhandled, unsubscribe. */
+	__ASSERT_NO_MSG(false);
+
+	return false;
+}
+
+APP_EVENT_LISTENER(MODULE, app_event_handler);
+APP_EVENT_SUBSCRIBE(MODULE, module_state_event);
+APP_EVENT_SUBSCRIBE(MODULE, hid_report_event);
+APP_EVENT_SUBSCRIBE(MODULE, hid_report_sent_event);
+APP_EVENT_SUBSCRIBE(MODULE, hid_report_subscription_event);
+APP_EVENT_SUBSCRIBE_EARLY(MODULE, config_event);
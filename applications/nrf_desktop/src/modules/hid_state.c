@@ -11,6 +11,7 @@
  */
 
 #include <limits.h>
+#include <inttypes.h>
 #include <sys/types.h>
 
 #include <zephyr/types.h>
@@ -49,6 +50,10 @@ enum state {
   #define CONFIG_USB_HID_DEVICE_COUNT	0
 #endif
 
+#ifndef CONFIG_DESKTOP_HID_STATE_PIPELINE_SINGLE_MIN_INTERVAL
+  #define CONFIG_DESKTOP_HID_STATE_PIPELINE_SINGLE_MIN_INTERVAL	0
+#endif
+
 #define SUBSCRIBER_COUNT (IS_ENABLED(CONFIG_DESKTOP_HIDS_ENABLE) + \
 			  CONFIG_USB_HID_DEVICE_COUNT)
 
@@ -75,6 +80,9 @@ enum state {
 
 #define AXIS_COUNT (IS_ENABLED(CONFIG_DESKTOP_HID_REPORT_MOUSE_SUPPORT) * MOUSE_REPORT_AXIS_COUNT)
 
+#define PIPELINE_DEPTH_MAX		2
+#define REG_CONN_INTERVAL_LLPM_MASK	0x0d00
+
 /**@brief HID state item. */
 struct item {
 	uint16_t usage_id; /**< HID usage ID. */
@@ -107,11 +115,18 @@ struct axis_data {
 	uint8_t axis_count; /**< Number of axes in this array. */
 };
 
+/**@brief Input timestamp. */
+struct input_ts {
+	uint32_t cycles; /**< Time of the first input. */
+	bool valid; /**< True if the timestamp is set. */
+};
+
 struct report_data {
 	struct items items;
 	struct eventq eventq;
 	struct axis_data axes;
 	struct report_state *linked_rs;
+	struct input_ts input_ts;
 };
 
 struct report_state {
@@ -150,6 +165,9 @@ static uint8_t report_data_index[REPORT_ID_COUNT];
 static uint8_t report_state_index[REPORT_ID_COUNT];
 static struct hid_state state;
 
+/* Connection interval of the Bluetooth LE subscriber, 0 if unknown. */
+static uint32_t ble_conn_interval_us;
+
 
 static bool report_send(struct report_state *rs,
 			struct report_data *rd,
@@ -437,6 +455,28 @@ static void clear_axes(struct axis_data *axes)
 	memset(axes->axis, 0, sizeof(axes->axis));
 }
 
+static void input_ts_mark(struct report_data *rd)
+{
+	if (!rd->input_ts.valid) {
+		rd->input_ts.cycles = k_cycle_get_32();
+		rd->input_ts.valid = true;
+	}
+}
+
+static uint32_t input_ts_take(struct report_data *rd)
+{
+	/* Reports without new input, for example the ones formed from the
+	 * constant empty report data, are stamped with the current time.
+	 */
+	if (!rd->input_ts.valid) {
+		return k_cycle_get_32();
+	}
+
+	rd->input_ts.valid = false;
+
+	return rd->input_ts.cycles;
+}
+
 static void clear_report_data(struct report_data *rd)
 {
 	LOG_INF("Clear report data (%p)", (void *)rd);
@@ -444,6 +484,7 @@ static void clear_report_data(struct report_data *rd)
 	clear_axes(&rd->axes);
 	clear_items(&rd->items);
 	eventq_reset(&rd->eventq);
+	rd->input_ts.valid = false;
 }
 
 static struct report_state *get_report_state(struct subscriber *subscriber,
@@ -603,6 +644,7 @@ static void send_report_keyboard(struct report_state *rs, struct report_data *rd
 							+ REPORT_SIZE_KEYBOARD_KEYS);
 	event->source = &state;
 	event->subscriber = rs->subscriber->id;
+	event->timestamp = input_ts_take(rd);
 
 	event->dyndata.data[0] = rs->report_id;
 	event->dyndata.data[2] = 0; /* Reserved byte */
@@ -699,6 +741,7 @@ static void send_report_mouse(struct report_state *rs, struct report_data *rd)
 
 	event->source = &state;
 	event->subscriber = rs->subscriber->id;
+	event->timestamp = input_ts_take(rd);
 
 	/* Convert to little-endian. */
 	uint8_t x_buff[sizeof(dx)];
@@ -773,6 +816,7 @@ static void send_report_boot_mouse(struct report_state *rs, struct report_data *
 
 	event->source = &state;
 	event->subscriber = rs->subscriber->id;
+	event->timestamp = input_ts_take(rd);
 
 	event->dyndata.data[0] = rs->report_id;
 	event->dyndata.data[1] = button_bm;
@@ -810,6 +854,7 @@ static void send_report_ctrl(struct report_state *rs, struct report_data *rd)
 
 	event->source = &state;
 	event->subscriber = rs->subscriber->id;
+	event->timestamp = input_ts_take(rd);
 
 	/* Only one item can fit in the consumer control report. */
 	__ASSERT_NO_MSG(report_size == sizeof(rs->report_id) +
@@ -851,6 +896,26 @@ static bool update_report(struct report_data *rd)
 	return rd->linked_rs->update_needed;
 }
 
+static unsigned int get_pipeline_depth(const struct report_state *rs)
+{
+	if ((rs->subscriber->is_usb) ||
+	    (rs->report_id == REPORT_ID_CONSUMER_CTRL) ||
+	    (rs->report_id == REPORT_ID_SYSTEM_CTRL))  {
+		return 1;
+	}
+
+	/* A second report in the pipeline is only needed if there is not enough
+	 * time to sample and form a new report between two connection events.
+	 * Otherwise, it only adds one connection interval of latency.
+	 */
+	if (IS_ENABLED(CONFIG_DESKTOP_HID_STATE_PIPELINE_ADAPTIVE) &&
+	    (ble_conn_interval_us >= CONFIG_DESKTOP_HID_STATE_PIPELINE_SINGLE_MIN_INTERVAL)) {
+		return 1;
+	}
+
+	return PIPELINE_DEPTH_MAX;
+}
+
 static bool report_send(struct report_state *rs,
 			struct report_data *rd,
 			bool check_state,
@@ -869,15 +934,7 @@ static bool report_send(struct report_state *rs,
 	}
 
 	if (!check_state || (rs->state != STATE_DISCONNECTED)) {
-		unsigned int pipeline_depth;
-
-		if ((rs->subscriber->is_usb) ||
-		    (rs->report_id == REPORT_ID_CONSUMER_CTRL) ||
-		    (rs->report_id == REPORT_ID_SYSTEM_CTRL))  {
-			pipeline_depth = 1;
-		} else {
-			pipeline_depth = 2;
-		}
+		unsigned int pipeline_depth = get_pipeline_depth(rs);
 
 		while ((rs->cnt < pipeline_depth) &&
 		       (rs->subscriber->report_cnt < rs->subscriber->report_max) &&
@@ -1336,6 +1393,7 @@ static void update_key(const struct hid_keymap *map, int16_t value)
 	} else {
 		/* Update state and issue report generation event. */
 		if (key_value_set(&rd->items, map->usage_id, value)) {
+			input_ts_mark(rd);
 			report_send(NULL, rd, false, true);
 		}
 	}
@@ -1432,6 +1490,8 @@ static bool handle_motion_event(const struct motion_event *event)
 	rd->axes.axis[MOUSE_REPORT_AXIS_X] += event->dx;
 	rd->axes.axis[MOUSE_REPORT_AXIS_Y] += event->dy;
 
+	input_ts_mark(rd);
+
 	report_send(NULL, rd, true, true);
 
 	return false;
@@ -1447,6 +1507,7 @@ static bool handle_wheel_event(const struct wheel_event *event)
 	__ASSERT_NO_MSG(rd != NULL);
 
 	rd->axes.axis[MOUSE_REPORT_AXIS_WHEEL] += event->wheel;
+	input_ts_mark(rd);
 
 	report_send(NULL, rd, true, true);
 
@@ -1546,6 +1607,7 @@ static bool handle_ble_peer_event(const struct ble_peer_event *event)
 	case PEER_STATE_DISCONNECTING:
 	case PEER_STATE_DISCONNECTED:
 		disconnect_subscriber(event->id);
+		ble_conn_interval_us = 0;
 		break;
 
 	case PEER_STATE_SECURED:
@@ -1561,6 +1623,34 @@ static bool handle_ble_peer_event(const struct ble_peer_event *event)
 	return false;
 }
 
+static uint32_t interval_reg_to_us(uint16_t reg)
+{
+	/* LLPM intervals are encoded as REG_CONN_INTERVAL_LLPM_MASK | interval in ms. */
+	if ((reg & REG_CONN_INTERVAL_LLPM_MASK) == REG_CONN_INTERVAL_LLPM_MASK) {
+		return (reg & BIT_MASK(8)) * USEC_PER_MSEC;
+	}
+
+	/* REG = interval / 1.25 ms */
+	return reg * 1250U;
+}
+
+static bool handle_ble_peer_conn_params_event(const struct ble_peer_conn_params_event *event)
+{
+	if (!event->updated) {
+		/* Ignore the connection parameters update request. */
+		return false;
+	}
+
+	ble_conn_interval_us = interval_reg_to_us(event->interval_max);
+
+	LOG_DBG("Connection interval %" PRIu32 " us, pipeline depth %u",
+		ble_conn_interval_us,
+		(ble_conn_interval_us >= CONFIG_DESKTOP_HID_STATE_PIPELINE_SINGLE_MIN_INTERVAL) ?
+		1 : PIPELINE_DEPTH_MAX);
+
+	return false;
+}
+
 static bool handle_usb_hid_event(const struct usb_hid_event *event)
 {
 	if (event->enabled) {
@@ -1623,6 +1713,12 @@ static bool app_event_handler(const struct app_event_header *aeh)
 		return handle_ble_peer_event(cast_ble_peer_event(aeh));
 	}
 
+	if (IS_ENABLED(CONFIG_DESKTOP_HID_STATE_PIPELINE_ADAPTIVE) &&
+	    is_ble_peer_conn_params_event(aeh)) {
+		return handle_ble_peer_conn_params_event(
+				cast_ble_peer_conn_params_event(aeh));
+	}
+
 	if (IS_ENABLED(CONFIG_DESKTOP_USB_ENABLE) &&
 	    is_usb_hid_event(aeh)) {
 		return handle_usb_hid_event(cast_usb_hid_event(aeh));
@@ -1640,6 +1736,9 @@ static bool app_event_handler(const struct app_event_header *aeh)
 
 APP_EVENT_LISTENER(MODULE, app_event_handler);
 APP_EVENT_SUBSCRIBE(MODULE, ble_peer_event);
+#ifdef CONFIG_DESKTOP_HID_STATE_PIPELINE_ADAPTIVE
+APP_EVENT_SUBSCRIBE(MODULE, ble_peer_conn_params_event);
+#endif /* CONFIG_DESKTOP_HID_STATE_PIPELINE_ADAPTIVE */
 APP_EVENT_SUBSCRIBE(MODULE, usb_hid_event);
 #ifdef CONFIG_DESKTOP_HID_REPORT_KEYBOARD_SUPPORT
 APP_EVENT_SUBSCRIBE(MODULE, hid_report_event);
@@ -226,6 +226,7 @@ static void broadcast_kbd_leds_report(struct bt_hids_rep *rep, struct bt_conn *c
 	event->source = conn;
 	/* Subscriber is not specified for HID output report. */
 	event->subscriber = NULL;
+	event->timestamp = k_cycle_get_32();
 	event->dyndata.data[0] = REPORT_ID_KEYBOARD_LEDS;
 	memcpy(&event->dyndata.data[1], rep->data, rep->size);
 
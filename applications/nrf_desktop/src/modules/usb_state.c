@@ -201,6 +201,7 @@ static int set_report(const struct device *dev,
 			event->source = usb_hid;
 			/* Subscriber is not specified for HID output report. */
 			event->subscriber = NULL;
+			event->timestamp = k_cycle_get_32();
 
 			uint8_t *buf = event->dyndata.data;
 
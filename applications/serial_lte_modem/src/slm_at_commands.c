@@ -574,27 +574,86 @@ int handle_at_clac(enum at_cmd_type cmd_type)
 	return ret;
 }
 
-int slm_at_parse(const char *at_cmd)
+/* Indexes of slm_at_cmd_list[] sorted by command string, for binary search */
+static uint8_t slm_at_cmd_index[ARRAY_SIZE(slm_at_cmd_list)];
+BUILD_ASSERT(ARRAY_SIZE(slm_at_cmd_list) <= UINT8_MAX + 1);
+
+static void cmd_index_init(void)
 {
-	int ret = -ENOENT;
-	int total = ARRAY_SIZE(slm_at_cmd_list);
+	/* Insertion sort, done once at init. The list is short and mostly sorted. */
+	for (int i = 0; i < ARRAY_SIZE(slm_at_cmd_list); i++) {
+		int j = i;
+
+		while (j > 0 && strcmp(slm_at_cmd_list[slm_at_cmd_index[j - 1]].string,
+				       slm_at_cmd_list[i].string) > 0) {
+			slm_at_cmd_index[j] = slm_at_cmd_index[j - 1];
+			j--;
+		}
+		slm_at_cmd_index[j] = i;
+	}
+}
 
-	for (int i = 0; i < total; i++) {
-		if (slm_util_cmd_casecmp(at_cmd, slm_at_cmd_list[i].string)) {
-			enum at_cmd_type type = at_parser_cmd_type_get(at_cmd);
+/* Case-insensitive compare of a command name of given length with an upper case
+ * command string.
+ */
+static int cmd_name_cmp(const char *name, size_t len, const char *string)
+{
+	size_t i;
 
-			at_params_list_clear(&at_param_list);
-			ret = at_parser_params_from_str(at_cmd, NULL, &at_param_list);
-			if (ret) {
-				LOG_ERR("Failed to parse AT command %d", ret);
-				return -EINVAL;
-			}
-			ret = slm_at_cmd_list[i].handler(type);
-			break;
+	for (i = 0; i < len; i++) {
+		int diff = toupper((int)name[i]) - (int)string[i];
+
+		if (diff != 0 || string[i] == '\0') {
+			return diff;
 		}
 	}
 
-	return ret;
+	return (string[i] == '\0') ? 0 : -1;
+}
+
+static struct slm_at_cmd *cmd_find(const char *at_cmd)
+{
+	/* Command name ends before parameters ("=") or READ/TEST suffix ("?") */
+	size_t len = strcspn(at_cmd, "=?");
+	int low = 0;
+	int high = ARRAY_SIZE(slm_at_cmd_list) - 1;
+
+	while (low <= high) {
+		int mid = (low + high) / 2;
+		struct slm_at_cmd *cmd = &slm_at_cmd_list[slm_at_cmd_index[mid]];
+		int diff = cmd_name_cmp(at_cmd, len, cmd->string);
+
+		if (diff == 0) {
+			return cmd;
+		} else if (diff < 0) {
+			high = mid - 1;
+		} else {
+			low = mid + 1;
+		}
+	}
+
+	return NULL;
+}
+
+int slm_at_parse(const char *at_cmd)
+{
+	int ret;
+	enum at_cmd_type type;
+	struct slm_at_cmd *cmd = cmd_find(at_cmd);
+
+	if (cmd == NULL) {
+		return -ENOENT;
+	}
+
+	type = at_parser_cmd_type_get(at_cmd);
+	at_params_list_clear(&at_param_list);
+	ret = at_parser_params_from_str(at_cmd, NULL, &at_param_list);
+	if (ret) {
+		LOG_ERR("Failed to parse AT command %d", ret);
+		return -EINVAL;
+	}
+
+	return cmd->handler(type);
 }
 
 int slm_at_init(void)
@@ -603,6 +662,7 @@ int slm_at_init(void)
 
 	k_work_init_delayable(&slm_work.uart_work, set_uart_wk);
 	k_work_init_delayable(&slm_work.sleep_work, go_sleep_wk);
+	cmd_index_init();
 
 	err = slm_at_tcp_proxy_init();
 	if (err) {
@@ -73,11 +73,14 @@ static struct k_work delayed_send_work;
 
 static uint8_t uart_rx_buf[UART_RX_BUF_NUM][UART_RX_LEN];
 static uint8_t *next_buf;
-static uint8_t *uart_tx_buf;
 static bool uart_recovery_pending;
 static struct k_work_delayable uart_recovery_work;
 
-static K_SEM_DEFINE(tx_done, 0, 1);
+/* TX ring, filled by uart_send() and drained from the UART callback */
+RING_BUF_DECLARE(tx_rb, CONFIG_SLM_UART_TX_BUF_SIZE);
+static uint32_t tx_len; /* Length of the ongoing transfer, 0 if idle */
+static K_MUTEX_DEFINE(tx_lock);
+static K_SEM_DEFINE(tx_space, 0, 1);
 
 /* global functions defined in different files */
 int slm_at_parse(const char *at_cmd);
@@ -95,9 +98,46 @@ uint16_t datamode_time_limit;                 /* Send trigger by time in data mo
 extern bool uart_configured;
 extern struct uart_config slm_uart;
 
-static int uart_send(const uint8_t *buffer, size_t len)
+/* Must be called from the UART callback or with interrupts locked. */
+static void uart_tx_next(void)
 {
+	uint8_t *data;
 	int ret;
+
+	tx_len = ring_buf_get_claim(&tx_rb, &data, CONFIG_SLM_UART_TX_BUF_SIZE);
+	if (tx_len == 0) {
+		return;
+	}
+
+	ret = uart_tx(uart_dev, data, tx_len, SYS_FOREVER_US);
+	if (ret) {
+		LOG_WRN("uart_tx failed: %d", ret);
+		(void)ring_buf_get_finish(&tx_rb, 0);
+		tx_len = 0;
+	}
+}
+
+static bool uart_tx_kick(void)
+{
+	unsigned int key;
+	bool busy;
+
+	key = irq_lock();
+	if (tx_len == 0) {
+		uart_tx_next();
+	}
+	busy = (tx_len != 0);
+	irq_unlock(key);
+
+	return busy;
+}
+
+/* Returns the number of bytes queued, which is less than len if the transfer stalled,
+ * or -EAGAIN if the UART is powered off.
+ */
+static int uart_send(const uint8_t *buffer, size_t len)
+{
+	size_t sent = 0;
 	enum pm_device_state state = PM_DEVICE_STATE_OFF;
 
 	pm_device_state_get(uart_dev, &state);
@@ -106,24 +146,122 @@ static int uart_send(const uint8_t *buffer, size_t len)
 		return -EAGAIN;
 	}
 
-	k_sem_take(&tx_done, K_FOREVER);
+	/* Queue the data behind what is already pending, so that small writes are sent
+	 * in the same transfer. Block while the ring is full, which throttles the caller
+	 * to the UART speed.
+	 */
+	k_mutex_lock(&tx_lock, K_FOREVER);
+	while (sent < len) {
+		sent += ring_buf_put(&tx_rb, buffer + sent, len - sent);
+
+		if (!uart_tx_kick()) {
+			if (sent < len) {
+				LOG_WRN("TX stalled, %zu bytes not queued", len - sent);
+			}
+			break;
+		}
+		if (sent < len) {
+			(void)k_sem_take(&tx_space, K_FOREVER);
+		}
+	}
+	k_mutex_unlock(&tx_lock);
+
+	return sent;
+}
+
+/* Must be called with tx_lock held. Returns when delayed_rb is empty, or when the
+ * UART does not take more data.
+ */
+static void delayed_flush(void)
+{
+	uint8_t *data = NULL;
+	uint32_t size;
+	int sent;
+
+	/* NOTE ring_buf_get_claim() might not return full size */
+	do {
+		size = ring_buf_get_claim(&delayed_rb, &data, UART_TX_DATA_SIZE);
+		if (size == 0) {
+			break;
+		}
+		sent = MAX(uart_send(data, size), 0);
+		(void)ring_buf_get_finish(&delayed_rb, sent);
+	} while (sent == (int)size);
+}
+
+/* Data that the UART does not take, because it is powered off or the transfer stalled,
+ * is kept in delayed_rb. It is sent before any new data, so the output stays in order.
+ */
+static void tx_send(const uint8_t *data, size_t len)
+{
+	int sent = 0;
+	uint32_t put;
+
+	k_mutex_lock(&tx_lock, K_FOREVER);
+	delayed_flush();
+	if (ring_buf_is_empty(&delayed_rb)) {
+		sent = MAX(uart_send(data, len), 0);
+	}
+	if (sent < len) {
+		put = ring_buf_put(&delayed_rb, data + sent, len - sent);
+		if (put < len - sent) {
+			LOG_WRN("Delayed TX buffer full, %zu bytes dropped", len - sent - put);
+		}
+	}
+	k_mutex_unlock(&tx_lock);
+}
+
+int rsp_claim(uint8_t **buf, size_t size)
+{
+	unsigned int key;
+	enum pm_device_state state = PM_DEVICE_STATE_OFF;
 
-	uart_tx_buf = k_malloc(len);
-	if (uart_tx_buf == NULL) {
-		LOG_WRN("No ram buffer");
-		k_sem_give(&tx_done);
+	if (size > CONFIG_SLM_UART_TX_BUF_SIZE) {
 		return -ENOMEM;
 	}
 
-	memcpy(uart_tx_buf, buffer, len);
-	ret = uart_tx(uart_dev, uart_tx_buf, len, SYS_FOREVER_US);
-	if (ret) {
-		LOG_WRN("uart_tx failed: %d", ret);
-		k_free(uart_tx_buf);
-		k_sem_give(&tx_done);
+	pm_device_state_get(uart_dev, &state);
+	if (state != PM_DEVICE_STATE_ACTIVE) {
+		(void)indicate_start();
+		return -EAGAIN;
 	}
 
-	return ret;
+	k_mutex_lock(&tx_lock, K_FOREVER);
+	/* Output kept back earlier goes first */
+	delayed_flush();
+	if (!ring_buf_is_empty(&delayed_rb)) {
+		k_mutex_unlock(&tx_lock);
+		return -EIO;
+	}
+
+	while (ring_buf_put_claim(&tx_rb, buf, size) < size) {
+		(void)ring_buf_put_finish(&tx_rb, 0);
+
+		key = irq_lock();
+		if (tx_len == 0 && ring_buf_is_empty(&tx_rb)) {
+			/* Rewind the empty ring so that all of it is contiguous */
+			ring_buf_reset(&tx_rb);
+			irq_unlock(key);
+			continue;
+		}
+		irq_unlock(key);
+
+		if (!uart_tx_kick()) {
+			LOG_WRN("TX stalled");
+			k_mutex_unlock(&tx_lock);
+			return -EIO;
+		}
+		(void)k_sem_take(&tx_space, K_FOREVER);
+	}
+
+	return 0;
+}
+
+void rsp_commit(size_t len)
+{
+	(void)ring_buf_put_finish(&tx_rb, len);
+	(void)uart_tx_kick();
+	k_mutex_unlock(&tx_lock);
 }
 
 void rsp_send(const char *str, size_t len)
@@ -133,9 +271,7 @@ void rsp_send(const char *str, size_t len)
 	}
 
 	LOG_HEXDUMP_DBG(str, len, "TX");
-	if (uart_send(str, len) < 0) {
-		ring_buf_put(&delayed_rb, str, len);
-	}
+	tx_send(str, len);
 }
 
 void data_send(const uint8_t *data, size_t len)
@@ -144,9 +280,7 @@ void data_send(const uint8_t *data, size_t len)
 		return;
 	}
 	LOG_HEXDUMP_DBG(data, MIN(len, HEXDUMP_DATAMODE_MAX), "TX-DATA");
-	if (uart_send(data, len) < 0) {
-		ring_buf_put(&delayed_rb, data, len);
-	}
+	tx_send(data, len);
 }
 
 static int uart_receive(void)
@@ -241,19 +375,11 @@ int poweroff_uart(void)
 
 static void delayed_send(struct k_work *work)
 {
-	uint8_t *data = NULL;
-	int size_send;
+	ARG_UNUSED(work);
 
-	/* NOTE ring_buf_get_claim() might not return full size */
-	do {
-		size_send = ring_buf_get_claim(&delayed_rb, &data, UART_TX_DATA_SIZE);
-		if (data != NULL && size_send > 0) {
-			(void)uart_send(data, size_send);
-			(void)ring_buf_get_finish(&delayed_rb, size_send);
-		} else {
-			break;
-		}
-	} while (true);
+	k_mutex_lock(&tx_lock, K_FOREVER);
+	delayed_flush();
+	k_mutex_unlock(&tx_lock);
 }
 
 int poweron_uart(void)
@@ -273,7 +399,8 @@ int poweron_uart(void)
 		return err;
 	}
 
-	k_sem_give(&tx_done);
+	/* Resume the transfer of data queued before power off */
+	(void)uart_tx_kick();
 	uart_send(SLM_SYNC_STR, sizeof(SLM_SYNC_STR)-1);
 	k_work_submit(&delayed_send_work);
 
@@ -404,6 +531,9 @@ int dfu_drv_tx(const uint8_t *data, uint16_t length)
 		encode_slip(rsp_buf, &slip_pkt_len, data, length);
 		LOG_HEXDUMP_DBG(rsp_buf, slip_pkt_len, "DFU-TX");
 		ret = uart_send(rsp_buf, slip_pkt_len);
+		if (ret >= 0) {
+			ret = (ret == slip_pkt_len) ? 0 : -EIO;
+		}
 	}
 
 	return ret;
@@ -476,7 +606,13 @@ int dfu_drv_tx(const uint8_t *data, uint16_t length)
 		return -EINVAL;
 	}
 
-	return uart_send(data, length);
+	int ret = uart_send(data, length);
+
+	if (ret >= 0) {
+		ret = (ret == length) ? 0 : -EIO;
+	}
+
+	return ret;
 }
 #endif /* CONFIG_SLM_NRF52_DFU_LEGACY */
 #endif /* CONFIG_SLM_NRF52_DFU */
@@ -900,12 +1036,15 @@ static void uart_callback(const struct device *dev, struct uart_event *evt, void
 
 	switch (evt->type) {
 	case UART_TX_DONE:
-		k_free(uart_tx_buf);
-		k_sem_give(&tx_done);
+		(void)ring_buf_get_finish(&tx_rb, tx_len);
+		k_sem_give(&tx_space);
+		uart_tx_next();
 		break;
 	case UART_TX_ABORTED:
-		k_free(uart_tx_buf);
-		k_sem_give(&tx_done);
+		/* The rest of the aborted transfer is dropped */
+		(void)ring_buf_get_finish(&tx_rb, tx_len);
+		tx_len = 0;
+		k_sem_give(&tx_space);
 		LOG_INF("TX_ABORTED");
 		break;
 	case UART_RX_RDY:
@@ -1044,7 +1183,6 @@ int slm_at_host_init(void)
 	k_work_init(&datamode_quit_work, datamode_quit);
 	k_work_init(&delayed_send_work, delayed_send);
 	k_work_init_delayable(&uart_recovery_work, uart_recovery);
-	k_sem_give(&tx_done);
 	rsp_send(SLM_SYNC_STR, sizeof(SLM_SYNC_STR)-1);
 	slm_fota_post_process();
 
@@ -57,6 +57,29 @@ void slm_at_host_uninit(void);
  */
 void rsp_send(const char *str, size_t len);
 
+/**
+ * @brief Claim space in the UART TX buffer for a response
+ *
+ * Lets the response be written directly into the UART TX buffer. Blocks until enough
+ * contiguous space is free. The TX buffer stays locked until rsp_commit() is called,
+ * which blocks all other UART output. Do not call anything that can block in between.
+ *
+ * @param buf Set to point to the claimed space
+ * @param size Size of the space to claim
+ *
+ * @retval 0 If the operation was successful.
+ *         Otherwise, a (negative) error code is returned.
+ */
+int rsp_claim(uint8_t **buf, size_t size);
+
+/**
+ * @brief Send the response written into the space claimed by rsp_claim()
+ *
+ * @param len Length of the response written, may be 0
+ *
+ */
+void rsp_commit(size_t len);
+
 /**
  * @brief Send raw data received in data mode
  *
@@ -721,11 +721,120 @@ static int do_send_datamode(const uint8_t *data, int datalen)
 	return (offset > 0) ? offset : -1;
 }
 
+/* Longest #XRECV or #XRECVFROM response header */
+#define RECV_HDR_MAX (sizeof("\r\n#XRECVFROM: 65535,\"\"\r\n") + NET_IPV6_ADDR_LEN)
+
+BUILD_ASSERT(CONFIG_SLM_UART_TX_BUF_SIZE >= RECV_HDR_MAX + SLM_MAX_PAYLOAD,
+	     "UART TX buffer too small for received data");
+
+/* Receive timeout of the socket in milliseconds, or -1 to wait forever. */
+static int recv_timeout_get(int sockfd)
+{
+	struct timeval tmo;
+	socklen_t len = sizeof(struct timeval);
+
+	if (getsockopt(sockfd, SOL_SOCKET, SO_RCVTIMEO, &tmo, &len) ||
+	    (tmo.tv_sec == 0 && tmo.tv_usec == 0)) {
+		return -1;
+	}
+
+	return tmo.tv_sec * MSEC_PER_SEC + tmo.tv_usec / USEC_PER_MSEC;
+}
+
+/* Receive from socket directly into the UART TX buffer, behind the response header.
+ * The data is placed behind a header of the same length as the previous one, so that
+ * it only needs to be moved when the header length changes.
+ *
+ * The claimed TX buffer blocks all other UART output, so the socket is only read
+ * without blocking. Waiting for data is done before the buffer is claimed, within
+ * the receive timeout (SO_RCVTIMEO) of the socket. -EAGAIN is returned if it expires.
+ */
+static int recv_rsp(int sockfd, size_t length, int flags, bool from, size_t *hdr_hint)
+{
+	int ret;
+	uint8_t *buf;
+	char hdr[RECV_HDR_MAX];
+	size_t hdr_len;
+	struct sockaddr remote;
+	socklen_t addrlen = sizeof(struct sockaddr);
+	struct pollfd fds = {
+		.fd = sockfd,
+		.events = POLLIN
+	};
+	int timeout = (flags & MSG_DONTWAIT) ? 0 : recv_timeout_get(sockfd);
+	int64_t start = k_uptime_get();
+
+	do {
+		/* Wait for data, unless the caller asked not to */
+		if (!(flags & MSG_DONTWAIT)) {
+			int remaining = -1;
+
+			if (timeout >= 0) {
+				remaining = MAX(timeout - (int)(k_uptime_get() - start), 0);
+			}
+
+			ret = poll(&fds, 1, remaining);
+			if (ret < 0) {
+				return -errno;
+			}
+			if (ret == 0) {
+				return -EAGAIN;
+			}
+		}
+
+		ret = rsp_claim(&buf, RECV_HDR_MAX + length);
+		if (ret) {
+			return ret;
+		}
+
+		if (from) {
+			ret = recvfrom(sockfd, buf + *hdr_hint, length, flags | MSG_DONTWAIT,
+				       &remote, &addrlen);
+		} else {
+			ret = recv(sockfd, buf + *hdr_hint, length, flags | MSG_DONTWAIT);
+		}
+		if (ret <= 0) {
+			ret = (ret < 0) ? -errno : 0;
+			rsp_commit(0);
+		}
+		/* POLLIN can be set before a complete TLS record has arrived */
+	} while (ret == -EAGAIN && !(flags & MSG_DONTWAIT));
+
+	if (ret <= 0) {
+		return ret;
+	}
+
+	if (from) {
+		char peer_addr[NET_IPV6_ADDR_LEN] = {0};
+
+		if (remote.sa_family == AF_INET) {
+			(void)inet_ntop(AF_INET, &((struct sockaddr_in *)&remote)->sin_addr,
+			    peer_addr, sizeof(peer_addr));
+		} else if (remote.sa_family == AF_INET6) {
+			(void)inet_ntop(AF_INET6, &((struct sockaddr_in6 *)&remote)->sin6_addr,
+			    peer_addr, sizeof(peer_addr));
+		}
+		hdr_len = snprintf(hdr, sizeof(hdr), "\r\n#XRECVFROM: %d,\"%s\"\r\n",
+				   ret, peer_addr);
+	} else {
+		hdr_len = snprintf(hdr, sizeof(hdr), "\r\n#XRECV: %d\r\n", ret);
+	}
+
+	if (hdr_len != *hdr_hint) {
+		memmove(buf + hdr_len, buf + *hdr_hint, ret);
+		*hdr_hint = hdr_len;
+	}
+	memcpy(buf, hdr, hdr_len);
+	rsp_commit(hdr_len + ret);
+
+	return ret;
+}
+
 static int do_recv(int timeout, int flags)
 {
+	static size_t hdr_hint;
 	int ret;
 	int sockfd = sock.fd;
-	char rx_data[SLM_MAX_PAYLOAD];
 	uint16_t length;
 
 	/* For TCP/TLS Server, receive from incoming socket */
@@ -758,10 +867,10 @@ static int do_recv(int timeout, int flags)
 	if (ret) {
 		return ret;
 	}
-	ret = recv(sockfd, (void *)rx_data, length, flags);
+	ret = recv_rsp(sockfd, length, flags, false, &hdr_hint);
 	if (ret < 0) {
-		LOG_WRN("recv() error: %d", -errno);
-		return -errno;
+		LOG_WRN("recv() error: %d", ret);
+		return ret;
 	}
 	/**
 	 * When a stream socket peer has performed an orderly shutdown,
@@ -773,9 +882,6 @@ static int do_recv(int timeout, int flags)
 	if (ret == 0) {
 		LOG_WRN("recv() return 0");
 	} else {
-		sprintf(rsp_buf, "\r\n#XRECV: %d\r\n", ret);
-		rsp_send(rsp_buf, strlen(rsp_buf));
-		rsp_send(rx_data, ret);
 		ret = 0;
 	}
 
@@ -867,10 +973,8 @@ static int do_sendto_datamode(const uint8_t *data, int datalen)
 
 static int do_recvfrom(int timeout, int flags)
 {
+	static size_t hdr_hint;
 	int ret;
-	struct sockaddr remote;
-	socklen_t addrlen = sizeof(struct sockaddr);
-	char rx_data[SLM_MAX_PAYLOAD];
 	int length;
 
 	if (sock.family == AF_INET) {
@@ -882,10 +986,10 @@ static int do_recvfrom(int timeout, int flags)
 	if (ret) {
 		return ret;
 	}
-	ret = recvfrom(sock.fd, (void *)rx_data, length, flags, &remote, &addrlen);
+	ret = recv_rsp(sock.fd, length, flags, true, &hdr_hint);
 	if (ret < 0) {
-		LOG_ERR("recvfrom() error: %d", -errno);
-		return -errno;
+		LOG_ERR("recvfrom() error: %d", ret);
+		return ret;
 	}
 	/**
 	 * Datagram sockets in various domains permit zero-length
@@ -894,19 +998,6 @@ static int do_recvfrom(int timeout, int flags)
 	 */
 	if (ret == 0) {
 		LOG_WRN("recvfrom() return 0");
-	} else {
-		char peer_addr[NET_IPV6_ADDR_LEN] = {0};
-
-		if (remote.sa_family == AF_INET) {
-			(void)inet_ntop(AF_INET, &((struct sockaddr_in *)&remote)->sin_addr,
-			    peer_addr, sizeof(peer_addr));
-		} else if (remote.sa_family == AF_INET6) {
-			(void)inet_ntop(AF_INET6, &((struct sockaddr_in6 *)&remote)->sin6_addr,
-			    peer_addr, sizeof(peer_addr));
-		}
-		sprintf(rsp_buf, "\r\n#XRECVFROM: %d,\"%s\"\r\n", ret, peer_addr);
-		rsp_send(rsp_buf, strlen(rsp_buf));
-		rsp_send(rx_data, ret);
 	}
 
 	return 0;
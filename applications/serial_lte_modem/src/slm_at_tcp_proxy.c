@@ -12,12 +12,10 @@
 #include "slm_native_tls.h"
 #include "slm_at_host.h"
 #include "slm_at_tcp_proxy.h"
+#include "slm_poll.h"
 
 LOG_MODULE_REGISTER(slm_tcp, CONFIG_SLM_LOG_LEVEL);
 
-#define THREAD_STACK_SIZE	KB(4)
-#define THREAD_PRIORITY		K_LOWEST_APPLICATION_THREAD_PRIO
-
 /* Some features need future modem firmware support */
 #define SLM_TCP_PROXY_FUTURE_FEATURE	0
 
@@ -37,10 +35,6 @@ enum slm_tcp_role {
 	TCP_ROLE_SERVER
 };
 
-static struct k_thread tcp_thread;
-static K_THREAD_STACK_DEFINE(tcp_thread_stack, THREAD_STACK_SIZE);
-static bool server_stop_pending;
-
 static struct tcp_proxy {
 	int sock;		/* Socket descriptor. */
 	int family;		/* Socket address family */
@@ -53,9 +47,11 @@ static struct tcp_proxy {
 extern struct at_param_list at_param_list;
 extern char rsp_buf[SLM_AT_CMD_RESPONSE_MAX_LEN];
 
-/** forward declaration of thread function **/
-static void tcpcli_thread_func(void *p1, void *p2, void *p3);
-static void tcpsvr_thread_func(void *p1, void *p2, void *p3);
+/** forward declaration of event handlers **/
+static void tcpsvr_event(int fd, short revents);
+static void tcpsvr_stop(int cause);
+static void tcpcli_event(int fd, short revents);
+static void tcpcli_stop(int cause);
 
 static int do_tcp_server_start(uint16_t port)
 {
@@ -193,11 +189,11 @@ static int do_tcp_server_start(uint16_t port)
 		goto exit_svr;
 	}
 
-	k_thread_create(&tcp_thread, tcp_thread_stack,
-			K_THREAD_STACK_SIZEOF(tcp_thread_stack),
-			tcpsvr_thread_func, NULL, NULL, NULL,
-			THREAD_PRIORITY, K_USER, K_NO_WAIT);
 	proxy.role = TCP_ROLE_SERVER;
+	ret = slm_poll_add(proxy.sock, POLLIN, tcpsvr_event);
+	if (ret) {
+		goto exit_svr;
+	}
 	sprintf(rsp_buf, "\r\n#XTCPSVR: %d,\"started\"\r\n", proxy.sock);
 	rsp_send(rsp_buf, strlen(rsp_buf));
 
@@ -222,34 +218,11 @@ exit_svr:
 
 static int do_tcp_server_stop(void)
 {
-	int ret;
-
-	if (proxy.sock == INVALID_SOCKET) {
-		return 0;
-	}
-#if defined(CONFIG_SLM_NATIVE_TLS)
-	if (proxy.sec_tag != INVALID_SEC_TAG) {
-		(void)slm_tls_unloadcrdl(proxy.sec_tag);
-		proxy.sec_tag = INVALID_SEC_TAG;
-	}
-#endif
-	server_stop_pending = true;
-	if (proxy.sock_peer != INVALID_SOCKET) {
-		(void)close(proxy.sock_peer);
-		proxy.sock_peer = INVALID_SOCKET;
-		sprintf(rsp_buf, "\r\n#XTCPSVR: 0,\"disconnected\"\r\n");
-		rsp_send(rsp_buf, strlen(rsp_buf));
-	} else {
-		ret = close(proxy.sock);
-		if (ret < 0) {
-			LOG_WRN("close() failed: %d", -errno);
-			return ret;
-		}
-		proxy.sock = INVALID_SOCKET;
-	}
-	if (k_thread_join(&tcp_thread, K_SECONDS(CONFIG_SLM_TCP_POLL_TIME + 1)) != 0) {
-		LOG_WRN("Wait for thread terminate failed");
+	slm_poll_lock();
+	if (proxy.sock != INVALID_SOCKET) {
+		tcpsvr_stop(0);
 	}
+	slm_poll_unlock();
 
 	return 0;
 }
@@ -311,12 +284,11 @@ static int do_tcp_client_connect(const char *url, uint16_t port)
 		goto exit_cli;
 	}
 
-	k_thread_create(&tcp_thread, tcp_thread_stack,
-			K_THREAD_STACK_SIZEOF(tcp_thread_stack),
-			tcpcli_thread_func, NULL, NULL, NULL,
-			THREAD_PRIORITY, K_USER, K_NO_WAIT);
-
 	proxy.role = TCP_ROLE_CLIENT;
+	ret = slm_poll_add(proxy.sock, POLLIN, tcpcli_event);
+	if (ret) {
+		goto exit_cli;
+	}
 	sprintf(rsp_buf, "\r\n#XTCPCLI: %d,\"connected\"\r\n", proxy.sock);
 	rsp_send(rsp_buf, strlen(rsp_buf));
 
@@ -333,26 +305,13 @@ exit_cli:
 
 static int do_tcp_client_disconnect(void)
 {
-	int ret = 0;
-
-	if (proxy.sock == INVALID_SOCKET) {
-		return 0;
-	}
-	ret = close(proxy.sock);
-	if (ret < 0) {
-		LOG_WRN("close() failed: %d", -errno);
-		ret = -errno;
-	} else {
-		proxy.sock = INVALID_SOCKET;
-	}
-	if (ret == 0 &&
-	    k_thread_join(&tcp_thread, K_SECONDS(CONFIG_SLM_TCP_POLL_TIME * 2)) != 0) {
-		LOG_WRN("Wait for thread terminate failed");
+	slm_poll_lock();
+	if (proxy.sock != INVALID_SOCKET) {
+		tcpcli_stop(0);
 	}
-	sprintf(rsp_buf, "\r\n#XTCPCLI: %d,\"disconnected\"\r\n", ret);
-	rsp_send(rsp_buf, strlen(rsp_buf));
+	slm_poll_unlock();
 
-	return ret;
+	return 0;
 }
 
 static int do_tcp_send(const uint8_t *data, int datalen)
@@ -429,6 +388,7 @@ static void tcpsvr_terminate_connection(int cause)
 		(void)exit_datamode(cause);
 	}
 	if (proxy.sock_peer != INVALID_SOCKET) {
+		(void)slm_poll_remove(proxy.sock_peer);
 		close(proxy.sock_peer);
 		proxy.sock_peer = INVALID_SOCKET;
 		sprintf(rsp_buf, "\r\n#XTCPSVR: %d,\"disconnected\"\r\n", cause);
@@ -436,236 +396,165 @@ static void tcpsvr_terminate_connection(int cause)
 	}
 }
 
-/* TCP server thread */
-static void tcpsvr_thread_func(void *p1, void *p2, void *p3)
+static void tcpsvr_stop(int cause)
 {
-	int ret;
-	struct pollfd fds[2];
-
-	ARG_UNUSED(p1);
-	ARG_UNUSED(p2);
-	ARG_UNUSED(p3);
-
-	fds[0].fd = proxy.sock;
-	fds[0].events = POLLIN;
-	/** The field fd contains a file descriptor for an open file.  If this field is negative,
-	 * then the corresponding events field is ignored and the revents field returns zero.
-	 */
-	fds[1].fd = INVALID_SOCKET;
-	fds[1].events = POLLIN;
-	while (true) {
-		ret = poll(fds, 2, MSEC_PER_SEC * CONFIG_SLM_TCP_POLL_TIME);
-		if (server_stop_pending) {  /* server wait to stop */
-			ret = 0;
-			break;
-		}
-		if (ret < 0) { /* IO error */
-			LOG_WRN("poll() error: %d", -errno);
-			ret = -EIO;
-			break;
-		}
-		if (ret == 0) { /* timeout */
-			continue;
-		}
-		LOG_DBG("fds[0] events 0x%08x", fds[0].revents);
-		LOG_DBG("fds[1] events 0x%08x", fds[1].revents);
-		/* Listening socket events must be handled first*/
-		if (fds[0].revents) {
-			if ((fds[0].revents & POLLERR) == POLLERR) {
-				LOG_ERR("0: POLLERR");
-				ret = -EIO;
-				break;
-			}
-			if ((fds[0].revents & POLLHUP) == POLLHUP) {
-				LOG_WRN("0: POLLHUP");
-				ret = -ECONNRESET;
-				break;
-			}
-			if ((fds[0].revents & POLLNVAL) == POLLNVAL) {
-				/* server stopped by AT command */
-				LOG_WRN("0: POLLNVAL");
-				ret = -ENETDOWN;
-				break;
-			}
-			if ((fds[0].revents & POLLIN) != POLLIN) {
-				/* Ignore and check whether there are client events */
-				goto client_events;
-			}
-
-			/* Accept incoming connection */
-			char peer_addr[INET6_ADDRSTRLEN] = {0};
-			socklen_t len;
-
-			if (proxy.family == AF_INET) {
-				struct sockaddr_in client;
-
-				len = sizeof(struct sockaddr_in);
-				ret = accept(proxy.sock, (struct sockaddr *)&client, &len);
-				if (ret == -1) {
-					LOG_WRN("accept(ipv4) error: %d", -errno);
-					goto client_events;
-				}
-				(void)inet_ntop(AF_INET, &client.sin_addr, peer_addr,
-					sizeof(peer_addr));
-			} else {
-				struct sockaddr_in6 client;
-
-				len = sizeof(struct sockaddr_in6);
-				ret = accept(proxy.sock, (struct sockaddr *)&client, &len);
-				if (ret == -1) {
-					LOG_WRN("accept(ipv6) error: %d", -errno);
-					goto client_events;
-				}
-				(void)inet_ntop(AF_INET6, &client.sin6_addr, peer_addr,
-					sizeof(peer_addr));
-			}
-			if (fds[1].fd >= 0) {
-				LOG_WRN("Full. Close connection.");
-				close(ret);
-				goto client_events;
-			}
-			proxy.sock_peer = ret;
-			fds[1].fd = proxy.sock_peer;
-			sprintf(rsp_buf, "\r\n#XTCPSVR: \"%s\",\"connected\"\r\n", peer_addr);
-			rsp_send(rsp_buf, strlen(rsp_buf));
-			LOG_DBG("New connection - %d", proxy.sock_peer);
-		}
-client_events:
-		/* Incoming socket events */
-		if (fds[1].revents) {
-			if ((fds[1].revents & POLLERR) == POLLERR) {
-				LOG_ERR("1: POLLERR");
-				tcpsvr_terminate_connection(-EIO);
-				fds[1].fd = INVALID_SOCKET;
-				continue;
-			}
-			if ((fds[1].revents & POLLHUP) == POLLHUP) {
-				LOG_ERR("1: POLLHUP");
-				tcpsvr_terminate_connection(-ECONNRESET);
-				fds[1].fd = INVALID_SOCKET;
-				continue;
-			}
-			if ((fds[1].revents & POLLNVAL) == POLLNVAL) {
-				LOG_WRN("1: POLLNVAL");
-				tcpsvr_terminate_connection(-ENETDOWN);
-				fds[1].fd = INVALID_SOCKET;
-				continue;
-			}
-			if ((fds[1].revents & POLLIN) != POLLIN) {
-				continue;
-			}
-			/* Receive data */
-			char rx_data[SLM_MAX_PAYLOAD];
-
-			ret = recv(fds[1].fd, (void *)rx_data, sizeof(rx_data), 0);
-			if (ret < 0) {
-				LOG_WRN("recv() error: %d", -errno);
-				continue;
-			}
-			if (ret == 0) {
-				continue;
-			}
-			if (in_datamode()) {
-				data_send(rx_data, ret);
-			} else {
-				rsp_send(rx_data, ret);
-				sprintf(rsp_buf, "\r\n#XTCPDATA: %d\r\n", ret);
-				rsp_send(rsp_buf, strlen(rsp_buf));
-			}
-		}
-	}
-
 #if defined(CONFIG_SLM_NATIVE_TLS)
 	if (proxy.sec_tag != INVALID_SEC_TAG) {
 		(void)slm_tls_unloadcrdl(proxy.sec_tag);
 		proxy.sec_tag = INVALID_SEC_TAG;
 	}
 #endif
-	tcpsvr_terminate_connection(ret);
-	if (proxy.sock != INVALID_SOCKET) {
-		(void)close(proxy.sock);
-		proxy.sock = INVALID_SOCKET;
-	}
-	sprintf(rsp_buf, "\r\n#XTCPSVR: %d,\"stopped\"\r\n", ret);
+	tcpsvr_terminate_connection(cause);
+	(void)slm_poll_remove(proxy.sock);
+	(void)close(proxy.sock);
+	proxy.sock = INVALID_SOCKET;
+	sprintf(rsp_buf, "\r\n#XTCPSVR: %d,\"stopped\"\r\n", cause);
 	rsp_send(rsp_buf, strlen(rsp_buf));
-	server_stop_pending = false;
-	LOG_INF("TCP server thread terminated");
+	LOG_INF("TCP server stopped");
 }
 
-/* TCP client thread */
-static void tcpcli_thread_func(void *p1, void *p2, void *p3)
+static void tcp_data_recv(int fd)
 {
 	int ret;
-	static struct pollfd fds;
-
-	ARG_UNUSED(p1);
-	ARG_UNUSED(p2);
-	ARG_UNUSED(p3);
-
-	fds.fd = proxy.sock;
-	fds.events = POLLIN;
-	while (true) {
-		ret = poll(&fds, 1, MSEC_PER_SEC * CONFIG_SLM_TCP_POLL_TIME);
-		if (ret < 0) {  /* IO error */
-			LOG_WRN("poll() error: %d", ret);
-			ret = -EIO;
-			break;
-		}
-		if (ret == 0) {  /* timeout */
-			continue;
-		}
-		LOG_DBG("Poll events 0x%08x", fds.revents);
-		if ((fds.revents & POLLERR) == POLLERR) {
-			LOG_ERR("POLLERR");
-			ret = -EIO;
-			break;
-		}
-		if ((fds.revents & POLLNVAL) == POLLNVAL) {
-			/* client disconnected locally by AT command */
-			LOG_WRN("POLLNVAL");
-			ret = -ENETDOWN;
-			break;
-		}
-		if ((fds.revents & POLLHUP) == POLLHUP) {
-			/* client disconnected by remote or lose LTE connection */
-			LOG_WRN("POLLHUP");
-			ret = -ECONNRESET;
-			break;
-		}
-		if ((fds.revents & POLLIN) != POLLIN) {
-			continue;
-		}
-		/* Receive data */
-		char rx_data[SLM_MAX_PAYLOAD];
+	char rx_data[SLM_MAX_PAYLOAD];
 
-		ret = recv(fds.fd, (void *)rx_data, sizeof(rx_data), 0);
-		if (ret < 0) {
-			LOG_WRN("recv() error: %d", -errno);
-			continue;
-		}
-		if (ret == 0) {
-			continue;
+	ret = recv(fd, (void *)rx_data, sizeof(rx_data), 0);
+	if (ret < 0) {
+		LOG_WRN("recv() error: %d", -errno);
+		return;
+	}
+	if (ret == 0) {
+		return;
+	}
+	if (in_datamode()) {
+		data_send(rx_data, ret);
+	} else {
+		rsp_send(rx_data, ret);
+		sprintf(rsp_buf, "\r\n#XTCPDATA: %d\r\n", ret);
+		rsp_send(rsp_buf, strlen(rsp_buf));
+	}
+}
+
+/* Incoming socket events */
+static void tcpsvr_peer_event(int fd, short revents)
+{
+	if ((revents & POLLERR) == POLLERR) {
+		LOG_ERR("1: POLLERR");
+		tcpsvr_terminate_connection(-EIO);
+		return;
+	}
+	if ((revents & POLLHUP) == POLLHUP) {
+		LOG_ERR("1: POLLHUP");
+		tcpsvr_terminate_connection(-ECONNRESET);
+		return;
+	}
+	if ((revents & POLLNVAL) == POLLNVAL) {
+		LOG_WRN("1: POLLNVAL");
+		tcpsvr_terminate_connection(-ENETDOWN);
+		return;
+	}
+	if ((revents & POLLIN) == POLLIN) {
+		tcp_data_recv(fd);
+	}
+}
+
+/* Listening socket events */
+static void tcpsvr_event(int fd, short revents)
+{
+	int ret;
+	char peer_addr[INET6_ADDRSTRLEN] = {0};
+	socklen_t len;
+
+	if ((revents & POLLERR) == POLLERR) {
+		LOG_ERR("0: POLLERR");
+		tcpsvr_stop(-EIO);
+		return;
+	}
+	if ((revents & POLLHUP) == POLLHUP) {
+		LOG_WRN("0: POLLHUP");
+		tcpsvr_stop(-ECONNRESET);
+		return;
+	}
+	if ((revents & POLLNVAL) == POLLNVAL) {
+		LOG_WRN("0: POLLNVAL");
+		tcpsvr_stop(-ENETDOWN);
+		return;
+	}
+	if ((revents & POLLIN) != POLLIN) {
+		return;
+	}
+
+	/* Accept incoming connection */
+	if (proxy.family == AF_INET) {
+		struct sockaddr_in client;
+
+		len = sizeof(struct sockaddr_in);
+		ret = accept(fd, (struct sockaddr *)&client, &len);
+		if (ret == -1) {
+			LOG_WRN("accept(ipv4) error: %d", -errno);
+			return;
 		}
-		if (in_datamode()) {
-			data_send(rx_data, ret);
-		} else {
-			rsp_send(rx_data, ret);
-			sprintf(rsp_buf, "\r\n#XTCPDATA: %d\r\n", ret);
-			rsp_send(rsp_buf, strlen(rsp_buf));
+		(void)inet_ntop(AF_INET, &client.sin_addr, peer_addr, sizeof(peer_addr));
+	} else {
+		struct sockaddr_in6 client;
+
+		len = sizeof(struct sockaddr_in6);
+		ret = accept(fd, (struct sockaddr *)&client, &len);
+		if (ret == -1) {
+			LOG_WRN("accept(ipv6) error: %d", -errno);
+			return;
 		}
+		(void)inet_ntop(AF_INET6, &client.sin6_addr, peer_addr, sizeof(peer_addr));
+	}
+	if (proxy.sock_peer != INVALID_SOCKET) {
+		LOG_WRN("Full. Close connection.");
+		close(ret);
+		return;
+	}
+	if (slm_poll_add(ret, POLLIN, tcpsvr_peer_event) != 0) {
+		close(ret);
+		return;
 	}
+	proxy.sock_peer = ret;
+	sprintf(rsp_buf, "\r\n#XTCPSVR: \"%s\",\"connected\"\r\n", peer_addr);
+	rsp_send(rsp_buf, strlen(rsp_buf));
+	LOG_DBG("New connection - %d", proxy.sock_peer);
+}
 
+static void tcpcli_stop(int cause)
+{
 	if (in_datamode()) {
-		(void)exit_datamode(ret);
-	}
-	if (proxy.sock != INVALID_SOCKET) {
-		(void)close(proxy.sock);
-		proxy.sock = INVALID_SOCKET;
-		sprintf(rsp_buf, "\r\n#XTCPCLI: %d,\"disconnected\"\r\n", ret);
-		rsp_send(rsp_buf, strlen(rsp_buf));
+		(void)exit_datamode(cause);
 	}
+	(void)slm_poll_remove(proxy.sock);
+	(void)close(proxy.sock);
+	proxy.sock = INVALID_SOCKET;
+	sprintf(rsp_buf, "\r\n#XTCPCLI: %d,\"disconnected\"\r\n", cause);
+	rsp_send(rsp_buf, strlen(rsp_buf));
+	LOG_INF("TCP client disconnected");
+}
 
-	LOG_INF("TCP client thread terminated");
+static void tcpcli_event(int fd, short revents)
+{
+	if ((revents & POLLERR) == POLLERR) {
+		LOG_ERR("POLLERR");
+		tcpcli_stop(-EIO);
+		return;
+	}
+	if ((revents & POLLNVAL) == POLLNVAL) {
+		LOG_WRN("POLLNVAL");
+		tcpcli_stop(-ENETDOWN);
+		return;
+	}
+	if ((revents & POLLHUP) == POLLHUP) {
+		/* client disconnected by remote or lose LTE connection */
+		LOG_WRN("POLLHUP");
+		tcpcli_stop(-ECONNRESET);
+		return;
+	}
+	if ((revents & POLLIN) == POLLIN) {
+		tcp_data_recv(fd);
+	}
 }
 
 /**@brief handle AT#XTCPSVR commands
@@ -850,7 +739,9 @@ int handle_at_tcp_hangup(enum at_cmd_type cmd_type)
 		if (handle != proxy.sock_peer) {
 			return -EINVAL;
 		}
+		slm_poll_lock();
 		tcpsvr_terminate_connection(-ECONNREFUSED);
+		slm_poll_unlock();
 		err = 0;
 		break;
 
@@ -12,12 +12,10 @@
 #include "slm_util.h"
 #include "slm_at_host.h"
 #include "slm_at_udp_proxy.h"
+#include "slm_poll.h"
 
 LOG_MODULE_REGISTER(slm_udp, CONFIG_SLM_LOG_LEVEL);
 
-#define THREAD_STACK_SIZE	KB(4)
-#define THREAD_PRIORITY		K_LOWEST_APPLICATION_THREAD_PRIO
-
 /*
  * Known limitation in this version
  * - Multiple concurrent
@@ -33,10 +31,6 @@ enum slm_udp_proxy_operation {
 	CLIENT_CONNECT6 = SERVER_START6
 };
 
-static struct k_thread udp_thread;
-static K_THREAD_STACK_DEFINE(udp_thread_stack, THREAD_STACK_SIZE);
-static k_tid_t udp_thread_id;
-
 /**@brief Proxy roles. */
 enum slm_udp_role {
 	UDP_ROLE_CLIENT,
@@ -58,8 +52,9 @@ static struct udp_proxy {
 extern struct at_param_list at_param_list;
 extern char rsp_buf[SLM_AT_CMD_RESPONSE_MAX_LEN];
 
-/** forward declaration of thread function **/
-static void udp_thread_func(void *p1, void *p2, void *p3);
+/** forward declaration of event handlers **/
+static void udp_event(int fd, short revents);
+static void udp_stop(int cause);
 
 static int do_udp_server_start(uint16_t port)
 {
@@ -123,12 +118,13 @@ static int do_udp_server_start(uint16_t port)
 		return -errno;
 	}
 
-	udp_thread_id = k_thread_create(&udp_thread, udp_thread_stack,
-			K_THREAD_STACK_SIZEOF(udp_thread_stack),
-			udp_thread_func, NULL, NULL, NULL,
-			THREAD_PRIORITY, K_USER, K_NO_WAIT);
-
 	proxy.role = UDP_ROLE_SERVER;
+	ret = slm_poll_add(proxy.sock, POLLIN, udp_event);
+	if (ret) {
+		close(proxy.sock);
+		proxy.sock = INVALID_SOCKET;
+		return ret;
+	}
 	sprintf(rsp_buf, "\r\n#XUDPSVR: %d,\"started\"\r\n", proxy.sock);
 	rsp_send(rsp_buf, strlen(rsp_buf));
 
@@ -137,32 +133,13 @@ static int do_udp_server_start(uint16_t port)
 
 static int do_udp_server_stop(void)
 {
-	int ret = 0;
-
-	if (proxy.sock == INVALID_SOCKET) {
-		return 0;
-	}
-	ret = close(proxy.sock);
-	if (ret < 0) {
-		LOG_WRN("close() failed: %d", -errno);
-		ret = -errno;
-	} else {
-		proxy.sock = INVALID_SOCKET;
-		if (proxy.family == AF_INET) {
-			memset(&proxy.remote, 0, sizeof(struct sockaddr_in));
-		} else {
-			memset(&proxy.remote6, 0, sizeof(struct sockaddr_in6));
-		}
-		(void)slm_at_udp_proxy_init();
-	}
-	if (ret == 0 &&
-	    k_thread_join(&udp_thread, K_SECONDS(CONFIG_SLM_UDP_POLL_TIME * 2)) != 0) {
-		LOG_WRN("Wait for thread terminate failed");
+	slm_poll_lock();
+	if (proxy.sock != INVALID_SOCKET) {
+		udp_stop(0);
 	}
-	sprintf(rsp_buf, "\r\n#XUDPSVR: %d,\"stopped\"\r\n", ret);
-	rsp_send(rsp_buf, strlen(rsp_buf));
+	slm_poll_unlock();
 
-	return ret;
+	return 0;
 }
 
 static int do_udp_client_connect(const char *url, uint16_t port)
@@ -215,12 +192,11 @@ static int do_udp_client_connect(const char *url, uint16_t port)
 		goto cli_exit;
 	}
 
-	udp_thread_id = k_thread_create(&udp_thread, udp_thread_stack,
-			K_THREAD_STACK_SIZEOF(udp_thread_stack),
-			udp_thread_func, NULL, NULL, NULL,
-			THREAD_PRIORITY, K_USER, K_NO_WAIT);
-
 	proxy.role = UDP_ROLE_CLIENT;
+	ret = slm_poll_add(proxy.sock, POLLIN, udp_event);
+	if (ret) {
+		goto cli_exit;
+	}
 	sprintf(rsp_buf, "\r\n#XUDPCLI: %d,\"connected\"\r\n", proxy.sock);
 	rsp_send(rsp_buf, strlen(rsp_buf));
 
@@ -237,26 +213,13 @@ cli_exit:
 
 static int do_udp_client_disconnect(void)
 {
-	int ret = 0;
-
-	if (proxy.sock == INVALID_SOCKET) {
-		return 0;
-	}
-	ret = close(proxy.sock);
-	if (ret < 0) {
-		LOG_WRN("close() failed: %d", -errno);
-		ret = -errno;
-	} else {
-		proxy.sock = INVALID_SOCKET;
-	}
-	if (ret == 0 &&
-	    k_thread_join(&udp_thread, K_SECONDS(CONFIG_SLM_UDP_POLL_TIME * 2)) != 0) {
-		LOG_WRN("Wait for thread terminate failed");
+	slm_poll_lock();
+	if (proxy.sock != INVALID_SOCKET) {
+		udp_stop(0);
 	}
-	sprintf(rsp_buf, "\r\n#XUDPCLI: %d,\"disconnected\"\r\n", ret);
-	rsp_send(rsp_buf, strlen(rsp_buf));
+	slm_poll_unlock();
 
-	return ret;
+	return 0;
 }
 
 static int do_udp_send(const uint8_t *data, int datalen)
@@ -333,100 +296,88 @@ static int do_udp_send_datamode(const uint8_t *data, int datalen)
 	return (offset > 0) ? offset : -1;
 }
 
-static void udp_thread_func(void *p1, void *p2, void *p3)
+static void udp_stop(int cause)
 {
-	int ret;
-	struct pollfd fds;
-
-	ARG_UNUSED(p1);
-	ARG_UNUSED(p2);
-	ARG_UNUSED(p3);
-
-	fds.fd = proxy.sock;
-	fds.events = POLLIN;
-
-	do {
-		ret = poll(&fds, 1, MSEC_PER_SEC * CONFIG_SLM_UDP_POLL_TIME);
-		if (ret < 0) {  /* IO error */
-			LOG_WRN("poll() error: %d", ret);
-			continue;
-		}
-		if (ret == 0) {  /* timeout */
-			continue;
-		}
-		LOG_DBG("Poll events 0x%08x", fds.revents);
-		if ((fds.revents & POLLERR) == POLLERR) {
-			LOG_WRN("POLLERR");
-			ret = -EIO;
-			break;
-		}
-		if ((fds.revents & POLLNVAL) == POLLNVAL) {
-			/* UDP client or server closed */
-			LOG_WRN("POLLNVAL");
-			ret = -ENETDOWN;
-			break;
-		}
-		if ((fds.revents & POLLHUP) == POLLHUP) {
-			/* Lose LTE connection */
-			LOG_WRN("POLLHUP");
-			ret = -ECONNRESET;
-			break;
-		}
-		if ((fds.revents & POLLIN) != POLLIN) {
-			continue;
+	if (in_datamode()) {
+		(void)exit_datamode(cause);
+	}
+	(void)slm_poll_remove(proxy.sock);
+	(void)close(proxy.sock);
+	proxy.sock = INVALID_SOCKET;
+	if (proxy.role == UDP_ROLE_CLIENT) {
+		sprintf(rsp_buf, "\r\n#XUDPCLI: %d,\"disconnected\"\r\n", cause);
+	} else {
+		if (proxy.family == AF_INET) {
+			memset(&proxy.remote, 0, sizeof(struct sockaddr_in));
+		} else {
+			memset(&proxy.remote6, 0, sizeof(struct sockaddr_in6));
 		}
-		/* Receive data */
-		char rx_data[SLM_MAX_PAYLOAD];
+		(void)slm_at_udp_proxy_init();
+		sprintf(rsp_buf, "\r\n#XUDPSVR: %d,\"stopped\"\r\n", cause);
+	}
+	rsp_send(rsp_buf, strlen(rsp_buf));
+	LOG_INF("UDP proxy stopped");
+}
 
-		if (proxy.role == UDP_ROLE_SERVER) {
-			/* remember remote from last recvfrom */
-			if (proxy.family == AF_INET) {
-				int size = sizeof(struct sockaddr_in);
+static void udp_event(int fd, short revents)
+{
+	int ret;
+	char rx_data[SLM_MAX_PAYLOAD];
 
-				memset(&proxy.remote, 0, sizeof(struct sockaddr_in));
-				ret = recvfrom(proxy.sock, (void *)rx_data, sizeof(rx_data), 0,
-					(struct sockaddr *)&(proxy.remote), &size);
-			} else {
-				int size = sizeof(struct sockaddr_in6);
+	if ((revents & POLLERR) == POLLERR) {
+		LOG_WRN("POLLERR");
+		udp_stop(-EIO);
+		return;
+	}
+	if ((revents & POLLNVAL) == POLLNVAL) {
+		/* UDP client or server closed */
+		LOG_WRN("POLLNVAL");
+		udp_stop(-ENETDOWN);
+		return;
+	}
+	if ((revents & POLLHUP) == POLLHUP) {
+		/* Lose LTE connection */
+		LOG_WRN("POLLHUP");
+		udp_stop(-ECONNRESET);
+		return;
+	}
+	if ((revents & POLLIN) != POLLIN) {
+		return;
+	}
 
-				memset(&proxy.remote6, 0, sizeof(struct sockaddr_in6));
-				ret = recvfrom(proxy.sock, (void *)rx_data, sizeof(rx_data), 0,
-					(struct sockaddr *)&(proxy.remote6), &size);
-			}
-		} else {
-			ret = recv(proxy.sock, (void *)rx_data, sizeof(rx_data), 0);
-		}
-		if (ret < 0) {
-			LOG_WRN("recv() error: %d", -errno);
-			continue;
-		}
-		if (ret == 0) {
-			continue;
-		}
-		if (in_datamode()) {
-			data_send(rx_data, ret);
-		} else {
-			rsp_send(rx_data, ret);
-			sprintf(rsp_buf, "\r\n#XUDPDATA: %d\r\n", ret);
-			rsp_send(rsp_buf, strlen(rsp_buf));
-		}
-	} while (true);
+	/* Receive data */
+	if (proxy.role == UDP_ROLE_SERVER) {
+		/* remember remote from last recvfrom */
+		if (proxy.family == AF_INET) {
+			int size = sizeof(struct sockaddr_in);
 
-	if (in_datamode()) {
-		(void)exit_datamode(ret);
-	}
-	if (proxy.sock != INVALID_SOCKET) {
-		(void)close(proxy.sock);
-		proxy.sock = INVALID_SOCKET;
-		if (proxy.role == UDP_ROLE_CLIENT) {
-			sprintf(rsp_buf, "\r\n#XUDPCLI: %d,\"disconnected\"\r\n", ret);
+			memset(&proxy.remote, 0, sizeof(struct sockaddr_in));
+			ret = recvfrom(fd, (void *)rx_data, sizeof(rx_data), 0,
+				(struct sockaddr *)&(proxy.remote), &size);
 		} else {
-			sprintf(rsp_buf, "\r\n#XUDPSVR: %d,\"stopped\"\r\n", ret);
+			int size = sizeof(struct sockaddr_in6);
+
+			memset(&proxy.remote6, 0, sizeof(struct sockaddr_in6));
+			ret = recvfrom(fd, (void *)rx_data, sizeof(rx_data), 0,
+				(struct sockaddr *)&(proxy.remote6), &size);
 		}
+	} else {
+		ret = recv(fd, (void *)rx_data, sizeof(rx_data), 0);
+	}
+	if (ret < 0) {
+		LOG_WRN("recv() error: %d", -errno);
+		return;
+	}
+	if (ret == 0) {
+		return;
+	}
+	if (in_datamode()) {
+		data_send(rx_data, ret);
+	} else {
+		rsp_send(rx_data, ret);
+		sprintf(rsp_buf, "\r\n#XUDPDATA: %d\r\n", ret);
 		rsp_send(rsp_buf, strlen(rsp_buf));
 	}
-
-	LOG_INF("UDP thread terminated");
 }
 
 static int udp_datamode_callback(uint8_t op, const uint8_t *data, int len)
@@ -606,8 +557,9 @@ int slm_at_udp_proxy_uninit(void)
 {
 	int ret = 0;
 
+	slm_poll_lock();
 	if (proxy.sock != INVALID_SOCKET) {
-		k_thread_abort(udp_thread_id);
+		(void)slm_poll_remove(proxy.sock);
 		ret = close(proxy.sock);
 		if (ret < 0) {
 			LOG_WRN("close() failed: %d", -errno);
@@ -615,6 +567,7 @@ int slm_at_udp_proxy_uninit(void)
 		}
 		proxy.sock = INVALID_SOCKET;
 	}
+	slm_poll_unlock();
 
 	return ret;
 }
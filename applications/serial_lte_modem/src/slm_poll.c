@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <zephyr/logging/log.h>
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include "slm_defines.h"
+#include "slm_poll.h"
+
+LOG_MODULE_REGISTER(slm_poll, CONFIG_SLM_LOG_LEVEL);
+
+#define THREAD_STACK_SIZE	KB(4)
+#define THREAD_PRIORITY		K_LOWEST_APPLICATION_THREAD_PRIO
+
+/* TCP server and its peer, TCP client, UDP server or client */
+#define SLM_POLL_FD_MAX		4
+
+static struct slm_poll_entry {
+	int fd;
+	short events;
+	slm_poll_handler_t handler;
+} entries[SLM_POLL_FD_MAX] = {
+	[0 ... (SLM_POLL_FD_MAX - 1)] = { .fd = INVALID_SOCKET }
+};
+
+/* Held while handlers run, so that removed sockets are not dispatched */
+static K_MUTEX_DEFINE(poll_lock);
+static K_SEM_DEFINE(poll_wake, 0, 1);
+
+static struct slm_poll_entry *entry_find(int fd)
+{
+	for (int i = 0; i < SLM_POLL_FD_MAX; i++) {
+		if (entries[i].fd == fd) {
+			return &entries[i];
+		}
+	}
+
+	return NULL;
+}
+
+int slm_poll_add(int fd, short events, slm_poll_handler_t handler)
+{
+	struct slm_poll_entry *entry;
+
+	if (fd < 0 || handler == NULL) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&poll_lock, K_FOREVER);
+	entry = entry_find(fd);
+	if (entry == NULL) {
+		entry = entry_find(INVALID_SOCKET);
+	}
+	if (entry == NULL) {
+		k_mutex_unlock(&poll_lock);
+		LOG_ERR("No room for socket %d", fd);
+		return -ENOMEM;
+	}
+	entry->fd = fd;
+	entry->events = events;
+	entry->handler = handler;
+	k_mutex_unlock(&poll_lock);
+
+	k_sem_give(&poll_wake);
+
+	return 0;
+}
+
+int slm_poll_remove(int fd)
+{
+	struct slm_poll_entry *entry;
+
+	if (fd < 0) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&poll_lock, K_FOREVER);
+	entry = entry_find(fd);
+	if (entry != NULL) {
+		entry->fd = INVALID_SOCKET;
+	}
+	k_mutex_unlock(&poll_lock);
+
+	return (entry != NULL) ? 0 : -ENOENT;
+}
+
+void slm_poll_lock(void)
+{
+	k_mutex_lock(&poll_lock, K_FOREVER);
+}
+
+void slm_poll_unlock(void)
+{
+	k_mutex_unlock(&poll_lock);
+}
+
+static void poll_thread_func(void *p1, void *p2, void *p3)
+{
+	int ret;
+	int nfds;
+	struct pollfd fds[SLM_POLL_FD_MAX];
+	struct slm_poll_entry *entry;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		nfds = 0;
+		k_mutex_lock(&poll_lock, K_FOREVER);
+		for (int i = 0; i < SLM_POLL_FD_MAX; i++) {
+			if (entries[i].fd != INVALID_SOCKET) {
+				fds[nfds].fd = entries[i].fd;
+				fds[nfds].events = entries[i].events;
+				nfds++;
+			}
+		}
+		k_mutex_unlock(&poll_lock);
+
+		if (nfds == 0) {
+			(void)k_sem_take(&poll_wake, K_FOREVER);
+			continue;
+		}
+
+		ret = poll(fds, nfds, CONFIG_SLM_SOCKET_POLL_PERIOD);
+		if (ret < 0) {
+			LOG_WRN("poll() error: %d", -errno);
+			k_sleep(K_MSEC(CONFIG_SLM_SOCKET_POLL_PERIOD));
+			continue;
+		}
+		if (ret == 0) {  /* timeout */
+			continue;
+		}
+
+		k_mutex_lock(&poll_lock, K_FOREVER);
+		for (int i = 0; i < nfds; i++) {
+			if (fds[i].revents == 0) {
+				continue;
+			}
+			LOG_DBG("fd %d events 0x%08x", fds[i].fd, fds[i].revents);
+			/* The socket may have been removed by a previous handler */
+			entry = entry_find(fds[i].fd);
+			if (entry != NULL) {
+				entry->handler(fds[i].fd, fds[i].revents);
+			}
+		}
+		k_mutex_unlock(&poll_lock);
+	}
+}
+
+K_THREAD_DEFINE(slm_poll_thread, THREAD_STACK_SIZE, poll_thread_func, NULL, NULL, NULL,
+		THREAD_PRIORITY, 0, 0);
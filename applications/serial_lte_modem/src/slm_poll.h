@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef SLM_POLL_
+#define SLM_POLL_
+
+/**@file slm_poll.h
+ *
+ * @brief Socket event loop for serial LTE modem.
+ * @{
+ */
+
+/**
+ * @brief Socket event handler.
+ *
+ * Called from the event loop thread.
+ *
+ * @param fd Socket descriptor.
+ * @param revents Events returned by poll().
+ */
+typedef void (*slm_poll_handler_t)(int fd, short revents);
+
+/**
+ * @brief Add a socket to the event loop.
+ *
+ * A socket added from outside the event loop is polled at the latest after
+ * CONFIG_SLM_SOCKET_POLL_PERIOD milliseconds.
+ *
+ * @param fd Socket descriptor.
+ * @param events Events to poll for.
+ * @param handler Handler called when any of the events, or an error, occur.
+ *
+ * @retval 0 If the operation was successful.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int slm_poll_add(int fd, short events, slm_poll_handler_t handler);
+
+/**
+ * @brief Remove a socket from the event loop.
+ *
+ * When this function returns, the handler is no longer running nor called for the socket.
+ *
+ * @param fd Socket descriptor.
+ *
+ * @retval 0 If the operation was successful.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int slm_poll_remove(int fd);
+
+/**
+ * @brief Prevent event handlers from running.
+ *
+ * Lets socket state shared with the event handlers be changed from other threads.
+ */
+void slm_poll_lock(void);
+
+/**
+ * @brief Allow event handlers to run again.
+ */
+void slm_poll_unlock(void);
+
+/** @} */
+#endif /* SLM_POLL_ */
@@ -113,6 +113,54 @@ int bt_nus_init(struct bt_nus_cb *callbacks);
  */
 int bt_nus_send(struct bt_conn *conn, const uint8_t *data, uint16_t len);
 
+/** @brief Statistics of the NUS stream. */
+struct bt_nus_stream_stats {
+	/** Number of bytes sent since the stream was opened. */
+	uint32_t tx_bytes;
+	/** Number of notifications sent since the stream was opened. */
+	uint32_t tx_notifications;
+	/** Number of bytes waiting to be sent. */
+	uint32_t backlog;
+	/** Highest number of bytes waiting to be sent. */
+	uint32_t backlog_peak;
+	/** Average throughput since the stream was opened, in bytes per second. */
+	uint32_t throughput;
+};
+
+/**@brief Queue data on the NUS stream.
+ *
+ * @details The data is copied to the stream buffer and sent to the peer in
+ *          notifications of the maximum size allowed by the ATT MTU. Several
+ *          notifications are kept in flight, see
+ *          CONFIG_BT_NUS_STREAM_PIPELINE_COUNT.
+ *
+ *          The stream is opened for the connection of the first call and
+ *          closed when that connection is disconnected. Data that has not
+ *          been sent is dropped at that point.
+ *
+ *          This function is only available if CONFIG_BT_NUS_STREAM is
+ *          enabled.
+ *
+ * @param[in] conn Pointer to connection object.
+ * @param[in] data Pointer to a data buffer.
+ * @param[in] len  Length of the data in the buffer.
+ *
+ * @return Number of bytes queued, which is less than @p len if the stream
+ *         buffer is full. -EINVAL if the peer has not enabled
+ *         notifications and -EBUSY if the stream is open for another
+ *         connection.
+ */
+int bt_nus_stream_send(struct bt_conn *conn, const uint8_t *data, size_t len);
+
+/**@brief Get the NUS stream statistics.
+ *
+ * @param[out] stats Statistics.
+ *
+ * @retval 0 If the operation was successful.
+ *           Otherwise, a negative value is returned.
+ */
+int bt_nus_stream_stats_get(struct bt_nus_stream_stats *stats);
+
 /**@brief Get maximum data length that can be used for @ref bt_nus_send.
  *
  * @param[in] conn Pointer to connection Object.
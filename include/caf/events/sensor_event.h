@@ -26,6 +26,9 @@ extern "C" {
 /* This value has to be equal to fractional part of the sensor_value. */
 #define FLOAT_TO_SENSOR_VAL_CONST 1000000
 
+/* Scale of the fixed-point values carried by the sensor_batch_event (milli-units). */
+#define SENSOR_BATCH_VAL_SCALE 1000
+
 /** @brief Sensor states. */
 enum sensor_state {
 	/** Initial state of the sensor. The state is used only before sensor is initialized and
@@ -89,6 +92,37 @@ struct sensor_event {
 	struct event_dyndata dyndata; /**< Sensor data. Provided as floating-point values. */
 };
 
+/** @brief Sensor batch event.
+ *
+ * The sensor batch event is submitted instead of #sensor_event for sensors configured to deliver
+ * samples in batches. A single event carries a number of consecutive samples of the sensor.
+ *
+ * The dyndata contains samples stored in a packed layout. Every sample consists of a 32-bit
+ * time offset (in microseconds) relative to @ref sensor_batch_event.timestamp followed by
+ * @ref sensor_batch_event.value_cnt signed 32-bit fixed-point values. The fixed-point values
+ * are expressed in units of 1/@ref SENSOR_BATCH_VAL_SCALE of the sensor unit. Use
+ * @ref sensor_batch_event_get_sample_time and @ref sensor_batch_event_get_sample_values to
+ * access the samples.
+ *
+ * The event also provides statistics of the sampling jitter, that is the absolute difference
+ * between the measured and the configured sampling period, for the intervals ending with samples
+ * that are part of the batch.
+ *
+ * @note The sensor batch event related to the given sensor must use the same description as
+ *       #sensor_state_event related to the sensor.
+ */
+struct sensor_batch_event {
+	struct app_event_header header; /**< Event header. */
+
+	const char *descr; /**< Description of the sensor. */
+	int64_t timestamp; /**< Time of the first sample in the batch, in microseconds of uptime. */
+	uint32_t jitter_max; /**< Maximum sampling jitter in microseconds. */
+	uint32_t jitter_avg; /**< Average sampling jitter in microseconds. */
+	uint8_t sample_cnt; /**< Number of samples in the batch. */
+	uint8_t value_cnt; /**< Number of fixed-point values in each sample. */
+	struct event_dyndata dyndata; /**< Packed samples. */
+};
+
 /** @brief Set sensor period event.
  *
  * The set sensor period event can be submitted by user to change sensor sampling period.
@@ -136,6 +170,84 @@ static inline struct sensor_value *sensor_event_get_data_ptr(const struct sensor
 	return (struct sensor_value *)event->dyndata.data;
 }
 
+/** @brief Get size of a single sample in the sensor batch event.
+ *
+ * @param[in] value_cnt   Number of values in the sample.
+ *
+ * @return Size of the sample, expressed as a number of 32-bit words.
+ */
+static inline size_t sensor_batch_sample_word_cnt(size_t value_cnt)
+{
+	return 1 + value_cnt;
+}
+
+/** @brief Get time offset of the sample in the sensor batch event.
+ *
+ * @param[in] event       Pointer to the sensor_batch_event.
+ * @param[in] idx         Index of the sample.
+ *
+ * @return Time offset of the sample relative to the batch timestamp, in microseconds.
+ */
+static inline uint32_t sensor_batch_event_get_sample_time(const struct sensor_batch_event *event,
+							  size_t idx)
+{
+	const uint32_t *words = (const uint32_t *)event->dyndata.data;
+
+	__ASSERT_NO_MSG(idx < event->sample_cnt);
+
+	return words[idx * sensor_batch_sample_word_cnt(event->value_cnt)];
+}
+
+/** @brief Get pointer to the fixed-point values of the sample in the sensor batch event.
+ *
+ * @param[in] event       Pointer to the sensor_batch_event.
+ * @param[in] idx         Index of the sample.
+ *
+ * @return Pointer to the array of @ref sensor_batch_event.value_cnt fixed-point values.
+ */
+static inline const int32_t *sensor_batch_event_get_sample_values(
+	const struct sensor_batch_event *event, size_t idx)
+{
+	const int32_t *words = (const int32_t *)event->dyndata.data;
+
+	__ASSERT_NO_MSG(idx < event->sample_cnt);
+
+	return &words[idx * sensor_batch_sample_word_cnt(event->value_cnt) + 1];
+}
+
+/**
+ * @brief Helper function for converting sensor_value to the sensor batch fixed-point value.
+ *
+ * Values outside of the range of the fixed-point representation are clamped to
+ * INT32_MIN or INT32_MAX.
+ *
+ * @param sensor_val Sensor value.
+ * @return Sensor value expressed in units of 1/SENSOR_BATCH_VAL_SCALE.
+ */
+static inline int32_t sensor_value_to_batch_val(struct sensor_value sensor_val)
+{
+	int64_t val = ((int64_t)sensor_val.val1 * SENSOR_BATCH_VAL_SCALE) +
+		      (sensor_val.val2 / (FLOAT_TO_SENSOR_VAL_CONST / SENSOR_BATCH_VAL_SCALE));
+
+	return (int32_t)CLAMP(val, INT32_MIN, INT32_MAX);
+}
+
+/**
+ * @brief Helper function for converting the sensor batch fixed-point value to sensor_value.
+ *
+ * @param batch_val Value expressed in units of 1/SENSOR_BATCH_VAL_SCALE.
+ * @return Sensor value.
+ */
+static inline struct sensor_value sensor_value_from_batch_val(int32_t batch_val)
+{
+	struct sensor_value result;
+
+	result.val1 = batch_val / SENSOR_BATCH_VAL_SCALE;
+	result.val2 = (batch_val % SENSOR_BATCH_VAL_SCALE) *
+		      (FLOAT_TO_SENSOR_VAL_CONST / SENSOR_BATCH_VAL_SCALE);
+	return result;
+}
+
 /**
  * @brief Helper function for checking if one sensor_value is greater than the other.
  *
@@ -184,6 +296,7 @@ extern "C" {
 #endif
 
 APP_EVENT_TYPE_DYNDATA_DECLARE(sensor_event);
+APP_EVENT_TYPE_DYNDATA_DECLARE(sensor_batch_event);
 
 #ifdef __cplusplus
 }
@@ -91,6 +91,14 @@ struct sm_sensor_config {
 	 * @brief Sampling period
 	 */
 	unsigned int sampling_period_ms;
+	/**
+	 * @brief Number of samples in a batch
+	 *
+	 * If set to a value greater than 1, the sensor manager buffers the given number of
+	 * consecutive samples and submits them as a single sensor_batch_event instead of
+	 * submitting a sensor_event for every sample.
+	 */
+	uint8_t batch_size;
 	/**
 	 * @brief Sensor trigger configuration
 	 *
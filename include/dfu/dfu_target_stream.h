@@ -99,6 +99,25 @@ int dfu_target_stream_write(const uint8_t *buf, size_t len);
  */
 int dfu_target_stream_done(bool successful);
 
+/**
+ * @brief Get the SHA-256 digest of the data written to the stream.
+ *
+ * The digest is calculated while the data is written, so it is available
+ * right after the stream has been completed successfully, without reading
+ * the image back from flash. If the stream was resumed, the data stored
+ * before the resume point is read back from flash once, on initialization.
+ *
+ * The option `CONFIG_DFU_TARGET_STREAM_HASH` must be set.
+ *
+ * @param[out] hash Buffer for the digest.
+ * @param[in] len Length of @p hash, must be at least 32 bytes.
+ *
+ * @retval 0 if successful.
+ * @retval -EACCES if the stream has not been completed successfully.
+ * @retval -ENOMEM if @p hash is too small.
+ */
+int dfu_target_stream_hash_get(uint8_t *hash, size_t len);
+
 #endif /* DFU_TARGET_STREAM_H__ */
 
 /**@} */
@@ -189,6 +189,24 @@ int ei_wrapper_get_timing(int *dsp_time, int *classification_time,
 			  int *anomaly_time);
 
 
+/** Get time spent on copying the input data to the library.
+ *
+ * The Edge Impulse library reads the input window from the wrapper's input
+ * buffer in chunks. The returned value is the total time spent on providing
+ * the input data for the last prediction.
+ *
+ * This function can be executed only from the wrapper's callback context.
+ * Otherwise, it returns a (negative) error code.
+ *
+ * @param[out] data_copy_time      Pointer to the variable that is used to store
+ *                                 the data copy time in microseconds.
+ *
+ * @retval 0 If the operation was successful.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int ei_wrapper_get_data_copy_time(uint32_t *data_copy_time);
+
+
 /** Initialize the Edge Impulse wrapper.
  *
  * @param[in] cb Callback used to receive results.
@@ -177,6 +177,14 @@ struct location_data_error {
 };
 #endif
 
+/** Location cache statistics. */
+struct location_cache_stats {
+	/** Number of cellular and Wi-Fi positions resolved from the cache. */
+	uint32_t hits;
+	/** Number of cellular and Wi-Fi positions requested from the location service. */
+	uint32_t misses;
+};
+
 /** Location event data. */
 struct location_event_data {
 	/** Event ID. */
@@ -478,6 +486,33 @@ void location_cellular_ext_result_set(
 	enum location_cellular_ext_result result,
 	struct location_data *location);
 
+/**
+ * @brief Get location cache statistics.
+ *
+ * @details Cellular and Wi-Fi positions are cached when CONFIG_LOCATION_CACHE is set.
+ * A new request is resolved from the cache if the serving cell is the same and
+ * the neighbor cells or Wi-Fi access points are similar enough to those seen
+ * when a cached position was resolved.
+ *
+ * @param[out] stats Cache statistics.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL @p stats is NULL.
+ * @retval -ENOTSUP CONFIG_LOCATION_CACHE is not set.
+ */
+int location_cache_stats_get(struct location_cache_stats *stats);
+
+/**
+ * @brief Clear the location cache and its statistics.
+ *
+ * @details Useful when the application knows that the device has moved, for example
+ * based on motion sensor data.
+ *
+ * @retval 0 on success.
+ * @retval -ENOTSUP CONFIG_LOCATION_CACHE is not set.
+ */
+int location_cache_clear(void);
+
 /** @} */
 
 #ifdef __cplusplus
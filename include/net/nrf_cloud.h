@@ -118,6 +118,11 @@ enum nrf_cloud_evt_type {
 	NRF_CLOUD_EVT_FOTA_DONE,
 	/** An error occurred during the FOTA update. */
 	NRF_CLOUD_EVT_FOTA_ERROR,
+	/** The device received a fragment of a data message that is larger than
+	 *  CONFIG_NRF_CLOUD_MQTT_PAYLOAD_BUFFER_LEN.
+	 *  Only sent if CONFIG_NRF_CLOUD_MQTT_RX_FRAGMENTS is enabled.
+	 */
+	NRF_CLOUD_EVT_RX_DATA_FRAGMENT,
 	/** An error occurred. The status field in the event struct will
 	 * be populated with a @ref nrf_cloud_error_status value
 	 */
@@ -369,6 +374,13 @@ struct nrf_cloud_evt {
 	struct nrf_cloud_data data;
 	/** Topic on which data was received. */
 	struct nrf_cloud_topic topic;
+	/** Position of the received data, for @ref NRF_CLOUD_EVT_RX_DATA_FRAGMENT. */
+	struct {
+		/** Offset of the data in the message. */
+		uint32_t offset;
+		/** Total length of the message. */
+		uint32_t total_len;
+	} fragment;
 };
 
 /**@brief Structure used to send pre-encoded data to nRF Cloud. */
@@ -383,6 +395,22 @@ struct nrf_cloud_tx_data {
 	uint32_t id;
 };
 
+/**@brief Outbox statistics, see @ref nrf_cloud_outbox_stats_get. */
+struct nrf_cloud_outbox_stats {
+	/** Number of messages waiting in the outbox. */
+	uint32_t queued_msgs;
+	/** Number of payload bytes waiting in the outbox. */
+	uint32_t queued_bytes;
+	/** Number of messages dropped because the outbox was full. */
+	uint32_t dropped_msgs;
+	/** Number of queued messages sent by the last flush. */
+	uint32_t last_flush_msgs;
+	/** Number of bytes published by the last flush, including batch framing. */
+	uint32_t last_flush_bytes;
+	/** Number of MQTT publishes used by the last flush. */
+	uint32_t last_flush_publishes;
+};
+
 /**@brief Controls which values are added to the FOTA array in the "serviceInfo" shadow section */
 struct nrf_cloud_svc_info_fota {
 	/** Flag to indicate if bootloader updates are supported */
@@ -675,15 +703,31 @@ int nrf_cloud_sensor_data_stream(const struct nrf_cloud_sensor_data *param);
  *
  * This API is used to send pre-encoded data to nRF Cloud.
  *
+ * If CONFIG_NRF_CLOUD_OUTBOX is enabled, messages for the message and bulk
+ * topics are copied to the outbox while the data channel is not connected,
+ * and sent once @ref NRF_CLOUD_EVT_READY has been received.
+ *
  * @param[in] msg Pointer to a structure containing data and topic
  *                information.
  *
- * @retval 0       If successful.
+ * @retval 0       If successful, or if the message was queued.
  * @retval -EACCES Cloud connection is not established; wait for @ref NRF_CLOUD_EVT_READY.
  * @return A negative value indicates an error.
  */
 int nrf_cloud_send(const struct nrf_cloud_tx_data *msg);
 
+/**
+ * @brief Get the outbox statistics.
+ *
+ * Only available if CONFIG_NRF_CLOUD_OUTBOX is enabled.
+ *
+ * @param[out] stats Statistics.
+ *
+ * @retval 0       If successful.
+ * @retval -EINVAL Invalid parameter.
+ */
+int nrf_cloud_outbox_stats_get(struct nrf_cloud_outbox_stats *const stats);
+
 /**
  * @brief Disconnect from the cloud.
  *
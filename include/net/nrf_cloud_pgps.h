@@ -160,6 +160,20 @@ struct nrf_cloud_pgps_init_param {
 	uint32_t storage_size;
 };
 
+/**@brief P-GPS download statistics, see @ref nrf_cloud_pgps_stats_get. */
+struct nrf_cloud_pgps_stats {
+	/** Number of requests for a full set of predictions. */
+	uint32_t full_requests;
+	/** Number of requests for only the missing or expired predictions. */
+	uint32_t partial_requests;
+	/** Number of partial requests made to resume an interrupted download. */
+	uint32_t resumed_requests;
+	/** Number of prediction data bytes received. */
+	uint32_t bytes_downloaded;
+	/** Number of prediction data bytes not downloaded thanks to partial requests. */
+	uint32_t bytes_saved;
+};
+
 /**@brief Update storage of the most recent known location, in modem-specific
  * normalized format (int32_t).
  * Current time is also stored.
@@ -278,6 +292,11 @@ int nrf_cloud_pgps_process_update(uint8_t *buf, size_t len);
  *
  * Not needed for custom download transports.
  *
+ * If the download ended before all requested predictions were stored, the
+ * predictions received so far are kept. The missing ones are requested on
+ * the next call to @ref nrf_cloud_pgps_preemptive_updates or
+ * @ref nrf_cloud_pgps_notify_prediction.
+ *
  * @retval 0 No failure.
  * @return a negative value indicates an error.
  */
@@ -328,6 +347,15 @@ bool nrf_cloud_pgps_loading(void);
  */
 int nrf_cloud_pgps_preemptive_updates(void);
 
+/**@brief Get P-GPS download statistics.
+ *
+ * @param[out] stats Statistics.
+ *
+ * @retval 0 Statistics copied.
+ * @retval -EINVAL Invalid parameter.
+ */
+int nrf_cloud_pgps_stats_get(struct nrf_cloud_pgps_stats *const stats);
+
 /**@brief Initialize P-GPS subsystem. Validates what is stored, then
  * requests any missing predictions, or full set if expired or missing.
  * When successful, it is ready to provide valid ephemeris predictions.
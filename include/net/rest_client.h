@@ -51,7 +51,10 @@ struct rest_client_req_context {
 	 */
 	int connect_socket;
 
-	/** Defines whether the connection should remain after API call. Default: false. */
+	/** Defines whether the connection should remain after API call. Default: false.
+	 *  If false and connect_socket is REST_CLIENT_SCKT_CONNECT, the connection is kept
+	 *  in the connection pool when CONFIG_REST_CLIENT_CONN_POOL is enabled.
+	 */
 	bool keep_alive;
 
 	/** Security tag. Default: REST_CLIENT_SEC_TAG_NO_SEC. */
@@ -130,6 +133,15 @@ struct rest_client_resp_context {
 
 	/** True if used_socket_id was kept alive and was not closed after the REST request. */
 	int used_socket_is_alive;
+
+	/** True if the request was sent over a connection taken from the connection pool. */
+	bool connection_reused;
+
+	/** Time used for opening and connecting the socket, in milliseconds. */
+	uint32_t connect_time_ms;
+
+	/** Time used for sending the request and receiving the response, in milliseconds. */
+	uint32_t transfer_time_ms;
 };
 
 /**
@@ -157,6 +169,14 @@ int rest_client_request(struct rest_client_req_context *req_ctx,
  */
 void rest_client_request_defaults_set(struct rest_client_req_context *req_ctx);
 
+/**
+ * @brief Closes all idle connections in the connection pool.
+ *
+ * @details Intended to be used when the network connection is lost, or before entering
+ *          a power saving state. Does nothing if CONFIG_REST_CLIENT_CONN_POOL is disabled.
+ */
+void rest_client_pool_clear(void);
+
 /** @} */
 
 #endif /* REST_CLIENT_H__ */
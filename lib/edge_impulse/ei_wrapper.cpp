@@ -51,6 +51,8 @@ static struct data_buffer ei_input;
 static ei_impulse_result_t ei_result;
 static int cur_res_idx;
 static ei_wrapper_result_ready_cb user_cb;
+static uint32_t copy_cycles;
+static uint32_t copy_time;
 
 
 BUILD_ASSERT(DATA_BUFFER_SIZE > INPUT_WINDOW_SIZE);
@@ -295,8 +297,12 @@ int ei_wrapper_start_prediction(size_t window_shift, size_t frame_shift)
 
 static int raw_feature_get_data(size_t offset, size_t length, float *out_ptr)
 {
+	uint32_t start = k_cycle_get_32();
+
 	buf_get(&ei_input, out_ptr, offset, length);
 
+	copy_cycles += k_cycle_get_32() - start;
+
 	return 0;
 }
 
@@ -324,9 +330,14 @@ static void edge_impulse_thread_fn(void)
 			start_time = k_uptime_get();
 		}
 
+		copy_cycles = 0;
+
 		/* Invoke the impulse. */
 		EI_IMPULSE_ERROR err = run_classifier(&features_signal,
 						      &ei_result, DEBUG_MODE);
+
+		copy_time = k_cyc_to_us_floor32(copy_cycles);
+
 		if (IS_ENABLED(CONFIG_EI_WRAPPER_PROFILING)) {
 			int64_t delta = k_uptime_delta(&start_time);
 
@@ -336,6 +347,7 @@ static void edge_impulse_thread_fn(void)
 				ei_result.timing.dsp,
 				ei_result.timing.classification,
 				ei_result.timing.anomaly);
+			LOG_INF("input data copy: %uus", copy_time);
 		}
 
 		if (err) {
@@ -456,6 +468,20 @@ int ei_wrapper_get_timing(int *dsp_time, int *classification_time, int *anomaly_
 	return 0;
 }
 
+int ei_wrapper_get_data_copy_time(uint32_t *data_copy_time)
+{
+	if (!can_read_result()) {
+		LOG_WRN("Result can be read only from callback context");
+		return -EACCES;
+	}
+
+	if (data_copy_time) {
+		*data_copy_time = copy_time;
+	}
+
+	return 0;
+}
+
 int ei_wrapper_init(ei_wrapper_result_ready_cb cb)
 {
 	if (!cb) {
@@ -236,3 +236,17 @@ void location_cellular_ext_result_set(
 	location_core_cellular_ext_result_set(result, location);
 #endif
 }
+
+#if !defined(CONFIG_LOCATION_CACHE)
+int location_cache_stats_get(struct location_cache_stats *stats)
+{
+	ARG_UNUSED(stats);
+
+	return -ENOTSUP;
+}
+
+int location_cache_clear(void)
+{
+	return -ENOTSUP;
+}
+#endif
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <modem/location.h>
+
+#include "location_cache.h"
+
+LOG_MODULE_DECLARE(location, CONFIG_LOCATION_LOG_LEVEL);
+
+#define MAC_ADDR_LEN 6
+
+struct location_cache_entry {
+	struct location_cache_key key;
+	double latitude;
+	double longitude;
+	float accuracy;
+	/** Uptime when the position was resolved, in milliseconds. */
+	int64_t stored_at;
+	/** Uptime of the last hit or store, used for LRU replacement. */
+	int64_t used_at;
+	bool valid;
+};
+
+static struct location_cache_entry entries[CONFIG_LOCATION_CACHE_SIZE];
+static struct location_cache_stats stats;
+static K_MUTEX_DEFINE(cache_mutex);
+
+#if defined(CONFIG_LOCATION_METHOD_CELLULAR)
+void location_cache_key_from_cells(struct location_cache_key *key,
+				   const struct lte_lc_cells_info *cells)
+{
+	memset(key, 0, sizeof(*key));
+
+	key->method = LOCATION_METHOD_CELLULAR;
+	key->mcc = cells->current_cell.mcc;
+	key->mnc = cells->current_cell.mnc;
+	key->tac = cells->current_cell.tac;
+	key->cell_id = cells->current_cell.id;
+
+	for (int i = 0; i < MIN(cells->ncells_count, LOCATION_CACHE_IDS_MAX); i++) {
+		key->ids[key->id_cnt++] =
+			((uint64_t)cells->neighbor_cells[i].earfcn << 16) |
+			cells->neighbor_cells[i].phys_cell_id;
+	}
+}
+#endif /* CONFIG_LOCATION_METHOD_CELLULAR */
+
+void location_cache_key_wifi_add(struct location_cache_key *key, const uint8_t *mac)
+{
+	uint64_t id = 0;
+
+	if (key->id_cnt >= LOCATION_CACHE_IDS_MAX) {
+		return;
+	}
+
+	for (int i = 0; i < MAC_ADDR_LEN; i++) {
+		id = (id << 8) | mac[i];
+	}
+
+	key->ids[key->id_cnt++] = id;
+}
+
+static bool entry_expired(const struct location_cache_entry *entry, int64_t now)
+{
+	return (now - entry->stored_at) >= (CONFIG_LOCATION_CACHE_TTL * MSEC_PER_SEC);
+}
+
+static bool key_similar(const struct location_cache_key *a, const struct location_cache_key *b)
+{
+	uint8_t common = 0;
+	uint8_t id_cnt_max = MAX(a->id_cnt, b->id_cnt);
+
+	if (a->method != b->method ||
+	    a->mcc != b->mcc || a->mnc != b->mnc ||
+	    a->tac != b->tac || a->cell_id != b->cell_id) {
+		return false;
+	}
+
+	if (id_cnt_max == 0) {
+		return true;
+	}
+
+	/* The sets are small, so a nested loop is cheaper than sorting. */
+	for (int i = 0; i < a->id_cnt; i++) {
+		for (int j = 0; j < b->id_cnt; j++) {
+			if (a->ids[i] == b->ids[j]) {
+				common++;
+				break;
+			}
+		}
+	}
+
+	return (common * 100) >= (CONFIG_LOCATION_CACHE_MATCH_PERCENT * id_cnt_max);
+}
+
+bool location_cache_lookup(const struct location_cache_key *key, struct location_data *location)
+{
+	struct location_cache_entry *entry;
+	int64_t now = k_uptime_get();
+	bool found = false;
+
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(entries); i++) {
+		entry = &entries[i];
+
+		if (!entry->valid) {
+			continue;
+		}
+
+		if (entry_expired(entry, now)) {
+			entry->valid = false;
+			continue;
+		}
+
+		if (key_similar(key, &entry->key)) {
+			location->latitude = entry->latitude;
+			location->longitude = entry->longitude;
+			location->accuracy = entry->accuracy;
+			entry->used_at = now;
+			found = true;
+			break;
+		}
+	}
+
+	if (found) {
+		stats.hits++;
+	} else {
+		stats.misses++;
+	}
+
+	k_mutex_unlock(&cache_mutex);
+
+	LOG_DBG("Location cache %s (hits %u, misses %u)", found ? "hit" : "miss",
+		stats.hits, stats.misses);
+
+	return found;
+}
+
+void location_cache_store(const struct location_cache_key *key,
+			  const struct location_data *location)
+{
+	struct location_cache_entry *entry = &entries[0];
+	int64_t now = k_uptime_get();
+
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+
+	/* Prefer a free or expired slot, otherwise replace the least recently used entry. */
+	for (int i = 0; i < ARRAY_SIZE(entries); i++) {
+		if (!entries[i].valid || entry_expired(&entries[i], now)) {
+			entry = &entries[i];
+			break;
+		}
+
+		if (entries[i].used_at < entry->used_at) {
+			entry = &entries[i];
+		}
+	}
+
+	entry->key = *key;
+	entry->latitude = location->latitude;
+	entry->longitude = location->longitude;
+	entry->accuracy = location->accuracy;
+	entry->stored_at = now;
+	entry->used_at = now;
+	entry->valid = true;
+
+	k_mutex_unlock(&cache_mutex);
+}
+
+int location_cache_stats_get(struct location_cache_stats *out)
+{
+	if (out == NULL) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+	*out = stats;
+	k_mutex_unlock(&cache_mutex);
+
+	return 0;
+}
+
+int location_cache_clear(void)
+{
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+	memset(entries, 0, sizeof(entries));
+	memset(&stats, 0, sizeof(stats));
+	k_mutex_unlock(&cache_mutex);
+
+	return 0;
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef LOCATION_CACHE_H
+#define LOCATION_CACHE_H
+
+#include <zephyr/sys/util.h>
+#include <modem/location.h>
+#if defined(CONFIG_LOCATION_METHOD_CELLULAR)
+#include <modem/lte_lc.h>
+#endif
+
+#if defined(CONFIG_LOCATION_METHOD_CELLULAR)
+#define LOCATION_CACHE_CELL_IDS_MAX CONFIG_LTE_NEIGHBOR_CELLS_MAX
+#else
+#define LOCATION_CACHE_CELL_IDS_MAX 0
+#endif
+
+#if defined(CONFIG_LOCATION_METHOD_WIFI)
+#define LOCATION_CACHE_WIFI_IDS_MAX CONFIG_LOCATION_METHOD_WIFI_SCANNING_RESULTS_MAX_CNT
+#else
+#define LOCATION_CACHE_WIFI_IDS_MAX 0
+#endif
+
+/** Maximum number of neighbor cells or access points in a cache key. */
+#define LOCATION_CACHE_IDS_MAX \
+	MAX(MAX(LOCATION_CACHE_CELL_IDS_MAX, LOCATION_CACHE_WIFI_IDS_MAX), 1)
+
+/** Radio environment seen by the device when the position was resolved. */
+struct location_cache_key {
+	/** Location method the position was resolved with. */
+	enum location_method method;
+	/** Serving cell, not used for Wi-Fi. */
+	int mcc;
+	int mnc;
+	uint32_t tac;
+	uint32_t cell_id;
+	/** Neighbor cells or access point MAC addresses, in any order. */
+	uint64_t ids[LOCATION_CACHE_IDS_MAX];
+	/** Number of valid entries in @ref ids. */
+	uint8_t id_cnt;
+};
+
+#if defined(CONFIG_LOCATION_METHOD_CELLULAR)
+/**
+ * @brief Create a cache key from cell measurement results.
+ *
+ * @param[out] key Key to fill.
+ * @param[in] cells Serving and neighbor cell information.
+ */
+void location_cache_key_from_cells(struct location_cache_key *key,
+				   const struct lte_lc_cells_info *cells);
+#endif
+
+/**
+ * @brief Add an access point to a Wi-Fi cache key.
+ *
+ * @param[in,out] key Key, must be zeroed with method set before the first call.
+ * @param[in] mac MAC address of the access point, 6 bytes.
+ */
+void location_cache_key_wifi_add(struct location_cache_key *key, const uint8_t *mac);
+
+/**
+ * @brief Look up a position resolved in a similar radio environment.
+ *
+ * @details The serving cell must match exactly. The neighbor cell or access point sets
+ * must overlap by at least CONFIG_LOCATION_CACHE_MATCH_PERCENT percent. Expired entries
+ * are ignored.
+ *
+ * @param[in] key Radio environment seen now.
+ * @param[out] location Latitude, longitude and accuracy are filled in on a hit.
+ *
+ * @retval true  If a matching position was found.
+ * @retval false If the position must be requested from the location service.
+ */
+bool location_cache_lookup(const struct location_cache_key *key, struct location_data *location);
+
+/**
+ * @brief Store a position resolved by the location service.
+ *
+ * @details The least recently used entry is replaced when the cache is full.
+ *
+ * @param[in] key Radio environment the position was resolved for.
+ * @param[in] location Resolved position.
+ */
+void location_cache_store(const struct location_cache_key *key,
+			  const struct location_data *location);
+
+#endif /* LOCATION_CACHE_H */
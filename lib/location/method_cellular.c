@@ -13,6 +13,9 @@
 
 #include "location_core.h"
 #include "location_utils.h"
+#if defined(CONFIG_LOCATION_CACHE)
+#include "location_cache.h"
+#endif
 
 LOG_MODULE_DECLARE(location, CONFIG_LOCATION_LOG_LEVEL);
 
@@ -140,6 +143,9 @@ static void method_cellular_positioning_work_fn(struct k_work *work)
 	struct multicell_location location;
 	struct location_data location_result = { 0 };
 	int64_t ncellmeas_time;
+#if defined(CONFIG_LOCATION_CACHE)
+	struct location_cache_key cache_key;
+#endif
 
 	if (cell_data.current_cell.id == LTE_LC_CELL_EUTRAN_ID_INVALID) {
 		LOG_WRN("Current cell ID not valid");
@@ -151,6 +157,18 @@ static void method_cellular_positioning_work_fn(struct k_work *work)
 	/* NCELLMEAS done at this point of time. Store current time to response. */
 	location_utils_systime_to_location_datetime(&location_result.datetime);
 
+#if defined(CONFIG_LOCATION_CACHE)
+	/* Skip the location service if the device still sees the same cells */
+	location_cache_key_from_cells(&cache_key, &cell_data);
+	if (location_cache_lookup(&cache_key, &location_result)) {
+		if (running) {
+			running = false;
+			location_core_event_cb(&location_result);
+		}
+		return;
+	}
+#endif
+
 	/* Check if timeout is given */
 	params.timeout = cellular_config.timeout;
 	if (cellular_config.timeout != SYS_FOREVER_MS) {
@@ -183,6 +201,9 @@ static void method_cellular_positioning_work_fn(struct k_work *work)
 		location_result.latitude = location.latitude;
 		location_result.longitude = location.longitude;
 		location_result.accuracy = location.accuracy;
+#if defined(CONFIG_LOCATION_CACHE)
+		location_cache_store(&cache_key, &location_result);
+#endif
 		if (running) {
 			running = false;
 			location_core_event_cb(&location_result);
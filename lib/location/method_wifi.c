@@ -15,6 +15,9 @@
 
 #include "location_core.h"
 #include "location_utils.h"
+#if defined(CONFIG_LOCATION_CACHE)
+#include "location_cache.h"
+#endif
 #include "wifi/wifi_service.h"
 
 LOG_MODULE_DECLARE(location, CONFIG_LOCATION_LOG_LEVEL);
@@ -41,6 +44,7 @@ static uint32_t latest_scan_result_count;
 
 struct method_wifi_scan_result {
 	char mac_addr_str[WIFI_MAC_ADDR_STR_LEN + 1];
+	uint8_t mac[WIFI_MAC_ADDR_LEN];
 	char ssid_str[WIFI_SSID_MAX_LEN + 1];
 	uint8_t channel;
 	int8_t rssi;
@@ -85,6 +89,7 @@ static void method_wifi_scan_result_handle(struct net_mgmt_event_callback *cb)
 			"%02x:%02x:%02x:%02x:%02x:%02x",
 			entry->mac[0], entry->mac[1], entry->mac[2],
 			entry->mac[3], entry->mac[4], entry->mac[5]);
+		memcpy(current->mac, entry->mac, WIFI_MAC_ADDR_LEN);
 		snprintf(current->ssid_str, entry->ssid_length + 1, "%s", entry->ssid);
 
 		current->channel = entry->channel;
@@ -154,6 +159,9 @@ static void method_wifi_positioning_work_fn(struct k_work *work)
 	const struct location_wifi_config wifi_config = work_data->wifi_config;
 	int64_t starting_uptime_ms = work_data->starting_uptime_ms;
 	int err;
+#if defined(CONFIG_LOCATION_CACHE)
+	struct location_cache_key cache_key = { .method = LOCATION_METHOD_WIFI };
+#endif
 
 	location_core_timer_start(wifi_config.timeout);
 
@@ -173,6 +181,23 @@ static void method_wifi_positioning_work_fn(struct k_work *work)
 	/* Scanning done at this point of time. Store current time to response. */
 	location_utils_systime_to_location_datetime(&location_result.datetime);
 
+#if defined(CONFIG_LOCATION_CACHE)
+	/* Skip the location service if the device still sees the same access points */
+	if (latest_scan_result_count > 1) {
+		for (int i = 0; i < latest_scan_result_count; i++) {
+			location_cache_key_wifi_add(&cache_key, latest_scan_results[i].mac);
+		}
+
+		if (location_cache_lookup(&cache_key, &location_result)) {
+			if (running) {
+				running = false;
+				location_core_event_cb(&location_result);
+			}
+			goto end;
+		}
+	}
+#endif
+
 	if (!location_utils_is_default_pdn_active()) {
 		/* Not worth to start trying to fetch with the REST api over cellular.
 		 * Thus, fail faster in this case and save the trying "costs".
@@ -218,6 +243,9 @@ static void method_wifi_positioning_work_fn(struct k_work *work)
 			location_result.latitude = result.latitude;
 			location_result.longitude = result.longitude;
 			location_result.accuracy = result.accuracy;
+#if defined(CONFIG_LOCATION_CACHE)
+			location_cache_store(&cache_key, &location_result);
+#endif
 			if (running) {
 				running = false;
 				location_core_event_cb(&location_result);
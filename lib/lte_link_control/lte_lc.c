@@ -348,6 +348,7 @@ static void at_handler_ncellmeas_gci(const char *response)
 
 	int max_cell_count = ncellmeas_params.gci_count;
 	struct lte_lc_cell *cells = NULL;
+	struct lte_lc_ncell *neighbor_cells;
 
 	LOG_DBG("%%NCELLMEAS GCI notification parsing starts");
 
@@ -359,7 +360,13 @@ static void at_handler_ncellmeas_gci(const char *response)
 		}
 	}
 
+	neighbor_cells = k_calloc(CONFIG_LTE_NEIGHBOR_CELLS_MAX, sizeof(struct lte_lc_ncell));
+	if (neighbor_cells == NULL) {
+		LOG_WRN("Failed to allocate memory for the neighbor cells (continue)");
+	}
+
 	evt.cells_info.gci_cells = cells;
+	evt.cells_info.neighbor_cells = neighbor_cells;
 	err = parse_ncellmeas_gci(&ncellmeas_params, resp, &evt.cells_info);
 
 	switch (err) {
@@ -382,7 +389,7 @@ static void at_handler_ncellmeas_gci(const char *response)
 	}
 
 	k_free(cells);
-	k_free(evt.cells_info.neighbor_cells);
+	k_free(neighbor_cells);
 }
 
 static void at_handler_ncellmeas(const char *response)
@@ -406,22 +413,17 @@ static void at_handler_ncellmeas(const char *response)
 		goto exit;
 	}
 
-	int ncell_count = neighborcell_count_get(response);
-	struct lte_lc_ncell *neighbor_cells = NULL;
-
-	LOG_DBG("%%NCELLMEAS notification: neighbor cell count: %d", ncell_count);
+	struct lte_lc_ncell *neighbor_cells;
 
-	if (ncell_count != 0) {
-		neighbor_cells = k_calloc(ncell_count, sizeof(struct lte_lc_ncell));
-		if (neighbor_cells == NULL) {
-			LOG_ERR("Failed to allocate memory for neighbor cells");
-			goto exit;
-		}
+	neighbor_cells = k_calloc(CONFIG_LTE_NEIGHBOR_CELLS_MAX, sizeof(struct lte_lc_ncell));
+	if (neighbor_cells == NULL) {
+		LOG_ERR("Failed to allocate memory for neighbor cells");
+		goto exit;
 	}
 
 	evt.cells_info.neighbor_cells = neighbor_cells;
 
-	err = parse_ncellmeas(response, &evt.cells_info);
+	err = parse_ncellmeas(response, &evt.cells_info, CONFIG_LTE_NEIGHBOR_CELLS_MAX);
 
 	switch (err) {
 	case -E2BIG:
@@ -439,9 +441,7 @@ static void at_handler_ncellmeas(const char *response)
 		break;
 	}
 
-	if (neighbor_cells) {
-		k_free(neighbor_cells);
-	}
+	k_free(neighbor_cells);
 exit:
 	ncellmeas_ongoing = false;
 }
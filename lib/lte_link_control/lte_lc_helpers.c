@@ -10,6 +10,8 @@
 #include <zephyr/net/socket.h>
 #include <string.h>
 #include <stdio.h>
+#include <ctype.h>
+#include <limits.h>
 #include <zephyr/device.h>
 #include <modem/lte_lc.h>
 #include <modem/at_cmd_parser.h>
@@ -211,20 +213,6 @@ static int get_edrx_value(enum lte_lc_lte_mode lte_mode, uint8_t idx, float *edr
 	return 0;
 }
 
-/* Counts the frequency of a character in a null-terminated string. */
-static uint32_t get_char_frequency(const char *str, char c)
-{
-	uint32_t count = 0;
-
-	do {
-		if (*str == c) {
-			count++;
-		}
-	} while (*(str++) != '\0');
-
-	return count;
-}
-
 /**@brief Helper function to check if a response is what was expected
  *
  * @param response Pointer to response prefix
@@ -712,296 +700,369 @@ clean_exit:
 	return err;
 }
 
-uint32_t neighborcell_count_get(const char *at_response)
+/* %NCELLMEAS notifications can contain hundreds of parameters. Instead of running
+ * the generic AT parser, which allocates a parameter list for the whole response,
+ * the parameters are read one by one directly from the response string.
+ */
+struct ncellmeas_tokenizer {
+	/* Start of the next parameter, NULL when all parameters have been read. */
+	const char *pos;
+};
+
+static bool ncellmeas_tokenizer_init(struct ncellmeas_tokenizer *t, const char *at_response)
 {
-	uint32_t comma_count, ncell_elements, ncell_count;
+	const size_t prefix_len = sizeof(AT_NCELLMEAS_RESPONSE_PREFIX) - 1;
+	const char *pos = at_response;
 
-	if (at_response == NULL) {
-		LOG_ERR("at_response is NULL, can't get cell count");
-		return 0;
+	while (isspace((int)*pos)) {
+		pos++;
 	}
 
-	comma_count = get_char_frequency(at_response, ',');
-	if (comma_count < AT_NCELLMEAS_PRE_NCELLS_PARAMS_COUNT) {
-		return 0;
+	if (strncmp(pos, AT_NCELLMEAS_RESPONSE_PREFIX, prefix_len) != 0 ||
+	    pos[prefix_len] != ':') {
+		return false;
+	}
+
+	pos += prefix_len + 1;
+
+	while (*pos == ' ') {
+		pos++;
 	}
 
-	/* Add one, as there's no comma after the last element. */
-	ncell_elements = comma_count - (AT_NCELLMEAS_PRE_NCELLS_PARAMS_COUNT - 1) + 1;
-	ncell_count = ncell_elements / AT_NCELLMEAS_N_PARAMS_COUNT;
+	t->pos = pos;
 
-	return ncell_count;
+	return true;
 }
 
-/* Parse NCELLMEAS notification and put information into struct lte_lc_cells_info.
- *
- * Returns 0 on successful cell measurements and population of struct.
- *	     The current cell information is valid if the current cell ID is
- *	     not set to LTE_LC_CELL_EUTRAN_ID_INVALID.
- *	     The ncells_count indicates how many neighbor cells were parsed
- *	     into the neighbor_cells array.
- * Returns 1 on measurement failure
- * Returns -E2BIG if not all cells were parsed due to memory limitations
- * Returns otherwise a negative error code.
- */
-int parse_ncellmeas(const char *at_response, struct lte_lc_cells_info *cells)
+static bool ncellmeas_tokenizer_done(const struct ncellmeas_tokenizer *t)
 {
-	int err, status, tmp, len;
-	struct at_param_list resp_list;
-	char  response_prefix[sizeof(AT_NCELLMEAS_RESPONSE_PREFIX)] = {0};
-	size_t response_prefix_len = sizeof(response_prefix);
-	char tmp_str[7];
-	bool incomplete = false;
-	/* Count the actual number of parameters in the AT response before
-	 * allocating heap for it. This may save quite a bit of heap as the
-	 * worst case scenario is 96 elements.
-	 * 3 is added to account for the parameters that do not have a trailng
-	 * comma.
-	 */
-	size_t param_count = get_char_frequency(at_response, ',') + 3;
+	return t->pos == NULL;
+}
 
-	cells->ncells_count = 0;
-	cells->current_cell.id = LTE_LC_CELL_EUTRAN_ID_INVALID;
+/* Gets the next parameter. Quotes are not included for string parameters. */
+static int ncellmeas_token_get(struct ncellmeas_tokenizer *t, const char **start, size_t *len)
+{
+	const char *pos = t->pos;
 
-	err = at_params_list_init(&resp_list, param_count);
-	if (err) {
-		LOG_ERR("Could not init AT params list, error: %d", err);
-		return err;
+	if (pos == NULL) {
+		return -ENODATA;
 	}
 
-	err = at_parser_params_from_str(at_response,
-					NULL,
-					&resp_list);
-	if (err && err != -E2BIG) {
-		LOG_ERR("Could not parse AT%%NCELLMEAS response, error: %d", err);
-		goto clean_exit;
-	} else if (err == -E2BIG) {
-		incomplete = true;
+	if (*pos == '"') {
+		const char *end = strchr(pos + 1, '"');
+
+		if (end == NULL) {
+			return -EBADMSG;
+		}
+
+		*start = pos + 1;
+		*len = end - *start;
+		pos = end + 1;
+	} else {
+		*start = pos;
+		pos += strcspn(pos, ",\r\n");
+		*len = pos - *start;
 	}
 
-	err = at_params_string_get(&resp_list,
-				   AT_RESPONSE_PREFIX_INDEX,
-				   response_prefix,
-				   &response_prefix_len);
+	t->pos = (*pos == ',') ? pos + 1 : NULL;
+
+	return 0;
+}
+
+static int ncellmeas_int64_get(struct ncellmeas_tokenizer *t, int base, int64_t *out)
+{
+	int err;
+	const char *start;
+	size_t len;
+	char buf[24];
+	char *end_ptr;
+
+	err = ncellmeas_token_get(t, &start, &len);
 	if (err) {
-		LOG_ERR("Could not get response prefix, error: %d", err);
-		goto clean_exit;
+		return err;
 	}
 
-	if (!response_is_valid(response_prefix, response_prefix_len,
-			       AT_NCELLMEAS_RESPONSE_PREFIX)) {
-		/* The unsolicited response is not a NCELLMEAS response, ignore it. */
-		LOG_DBG("Not a valid NCELLMEAS response");
-		goto clean_exit;
+	if (len == 0 || len >= sizeof(buf)) {
+		return -EBADMSG;
 	}
 
-	/* Status code. */
-	err = at_params_int_get(&resp_list, AT_NCELLMEAS_STATUS_INDEX, &status);
-	if (err) {
-		goto clean_exit;
-	}
+	memcpy(buf, start, len);
+	buf[len] = '\0';
 
-	if (status != AT_NCELLMEAS_STATUS_VALUE_SUCCESS) {
-		err = 1;
-		goto clean_exit;
+	errno = 0;
+	*out = strtoll(buf, &end_ptr, base);
+	if (*end_ptr != '\0' || errno == ERANGE) {
+		return -EBADMSG;
 	}
 
-	/* Current cell ID. */
-	err = string_param_to_int(&resp_list, AT_NCELLMEAS_CELL_ID_INDEX, &tmp, 16);
+	return 0;
+}
+
+static int ncellmeas_int_get(struct ncellmeas_tokenizer *t, int base, int *out)
+{
+	int err;
+	int64_t tmp;
+
+	err = ncellmeas_int64_get(t, base, &tmp);
 	if (err) {
-		goto clean_exit;
+		return err;
 	}
 
-	if (tmp > LTE_LC_CELL_EUTRAN_ID_MAX) {
-		tmp = LTE_LC_CELL_EUTRAN_ID_INVALID;
+	if (tmp < INT_MIN || tmp > INT_MAX) {
+		return -EBADMSG;
 	}
-	cells->current_cell.id = tmp;
 
-	/* PLMN */
-	len = sizeof(tmp_str);
+	*out = tmp;
+
+	return 0;
+}
 
-	err = at_params_string_get(&resp_list, AT_NCELLMEAS_PLMN_INDEX,
-				   tmp_str, &len);
+static int ncellmeas_plmn_get(struct ncellmeas_tokenizer *t, int *mcc, int *mnc)
+{
+	int err;
+	const char *start;
+	size_t len;
+	char tmp_str[7];
+
+	err = ncellmeas_token_get(t, &start, &len);
 	if (err) {
-		goto clean_exit;
+		return err;
+	}
+
+	/* Three characters long MCC followed by two or three characters long MNC. */
+	if (len <= 3 || len >= sizeof(tmp_str)) {
+		return -EBADMSG;
 	}
 
+	memcpy(tmp_str, start, len);
 	tmp_str[len] = '\0';
 
-	/* Read MNC and store as integer. The MNC starts as the fourth character
-	 * in the string, following three characters long MCC.
-	 */
-	err = string_to_int(&tmp_str[3], 10, &cells->current_cell.mnc);
+	err = string_to_int(&tmp_str[3], 10, mnc);
 	if (err) {
-		goto clean_exit;
+		return err;
 	}
 
-	/* Null-terminated MCC, read and store it. */
 	tmp_str[3] = '\0';
 
-	err = string_to_int(tmp_str, 10, &cells->current_cell.mcc);
+	return string_to_int(tmp_str, 10, mcc);
+}
+
+/* Parses the cell information that is common for all search types. GCI search types
+ * have the timing advance measurement time following the timing advance.
+ */
+static int ncellmeas_cell_get(struct ncellmeas_tokenizer *t, struct lte_lc_cell *cell, bool gci)
+{
+	int err, tmp;
+	int64_t tmp64;
+
+	/* <cell_id> */
+	err = ncellmeas_int64_get(t, 16, &tmp64);
 	if (err) {
-		goto clean_exit;
+		return err;
 	}
 
-	/* Tracking area code. */
-	err = string_param_to_int(&resp_list, AT_NCELLMEAS_TAC_INDEX, &tmp, 16);
+	if (tmp64 < 0 || tmp64 > LTE_LC_CELL_EUTRAN_ID_MAX) {
+		tmp64 = LTE_LC_CELL_EUTRAN_ID_INVALID;
+	}
+	cell->id = tmp64;
+
+	/* <plmn> */
+	err = ncellmeas_plmn_get(t, &cell->mcc, &cell->mnc);
 	if (err) {
-		goto clean_exit;
+		return err;
 	}
 
-	cells->current_cell.tac = tmp;
+	/* <tac> */
+	err = ncellmeas_int_get(t, 16, &tmp);
+	if (err) {
+		return err;
+	}
+	cell->tac = tmp;
 
-	/* Timing advance */
-	err = at_params_int_get(&resp_list, AT_NCELLMEAS_TIMING_ADV_INDEX,
-				&tmp);
+	/* <ta> */
+	err = ncellmeas_int_get(t, 10, &tmp);
 	if (err) {
-		goto clean_exit;
+		return err;
 	}
+	cell->timing_advance = tmp;
 
-	cells->current_cell.timing_advance = tmp;
+	if (gci) {
+		/* <ta_meas_time> */
+		err = ncellmeas_int64_get(t, 10, &tmp64);
+		if (err) {
+			return err;
+		}
+		cell->timing_advance_meas_time = tmp64;
+	}
 
-	/* EARFCN */
-	err = at_params_int_get(&resp_list, AT_NCELLMEAS_EARFCN_INDEX,
-				&cells->current_cell.earfcn);
+	/* <earfcn> */
+	err = ncellmeas_int_get(t, 10, &tmp);
 	if (err) {
-		goto clean_exit;
+		return err;
 	}
+	cell->earfcn = tmp;
 
-	/* Physical cell ID. */
-	err = at_params_short_get(&resp_list, AT_NCELLMEAS_PHYS_CELL_ID_INDEX,
-				&cells->current_cell.phys_cell_id);
+	/* <phys_cell_id> */
+	err = ncellmeas_int_get(t, 10, &tmp);
 	if (err) {
-		goto clean_exit;
+		return err;
 	}
+	cell->phys_cell_id = tmp;
 
-	/* RSRP */
-	err = at_params_int_get(&resp_list, AT_NCELLMEAS_RSRP_INDEX, &tmp);
+	/* <rsrp> */
+	err = ncellmeas_int_get(t, 10, &tmp);
 	if (err) {
-		goto clean_exit;
+		return err;
 	}
+	cell->rsrp = tmp;
 
-	cells->current_cell.rsrp = tmp;
+	/* <rsrq> */
+	err = ncellmeas_int_get(t, 10, &tmp);
+	if (err) {
+		return err;
+	}
+	cell->rsrq = tmp;
 
-	/* RSRQ */
-	err = at_params_int_get(&resp_list, AT_NCELLMEAS_RSRQ_INDEX, &tmp);
+	/* <meas_time> */
+	err = ncellmeas_int64_get(t, 10, &tmp64);
 	if (err) {
-		goto clean_exit;
+		return err;
 	}
+	cell->measurement_time = tmp64;
+
+	return 0;
+}
+
+/* Parses the neighbor cell parameters following the <n_earfcn>, which has already
+ * been read by the caller.
+ */
+static int ncellmeas_ncell_get(struct ncellmeas_tokenizer *t, int64_t earfcn,
+			       struct lte_lc_ncell *ncell)
+{
+	int err, tmp;
 
-	cells->current_cell.rsrq = tmp;
+	ncell->earfcn = earfcn;
 
-	/* Measurement time. */
-	err = at_params_int64_get(&resp_list, AT_NCELLMEAS_MEASUREMENT_TIME_INDEX,
-				  &cells->current_cell.measurement_time);
+	/* <n_phys_cell_id> */
+	err = ncellmeas_int_get(t, 10, &tmp);
 	if (err) {
-		goto clean_exit;
+		return err;
 	}
+	ncell->phys_cell_id = tmp;
 
-	/* Neighbor cell count. */
-	cells->ncells_count = neighborcell_count_get(at_response);
+	/* <n_rsrp> */
+	err = ncellmeas_int_get(t, 10, &tmp);
+	if (err) {
+		return err;
+	}
+	ncell->rsrp = tmp;
 
-	/* Starting from modem firmware v1.3.1, timing advance measurement time
-	 * information is added as the last parameter in the response.
-	 */
-	size_t ta_meas_time_index = AT_NCELLMEAS_PRE_NCELLS_PARAMS_COUNT +
-			cells->ncells_count * AT_NCELLMEAS_N_PARAMS_COUNT;
+	/* <n_rsrq> */
+	err = ncellmeas_int_get(t, 10, &tmp);
+	if (err) {
+		return err;
+	}
+	ncell->rsrq = tmp;
 
-	if (at_params_valid_count_get(&resp_list) > ta_meas_time_index) {
-		err = at_params_int64_get(&resp_list, ta_meas_time_index,
-					  &cells->current_cell.timing_advance_meas_time);
-		if (err) {
-			goto clean_exit;
-		}
-	} else {
-		cells->current_cell.timing_advance_meas_time = 0;
+	/* <time_diff> */
+	return ncellmeas_int_get(t, 10, &ncell->time_diff);
+}
+
+/* Parse NCELLMEAS notification and put information into struct lte_lc_cells_info.
+ *
+ * Returns 0 on successful cell measurements and population of struct.
+ *	     The current cell information is valid if the current cell ID is
+ *	     not set to LTE_LC_CELL_EUTRAN_ID_INVALID.
+ *	     The ncells_count indicates how many neighbor cells were parsed
+ *	     into the neighbor_cells array.
+ * Returns 1 on measurement failure
+ * Returns -E2BIG if there were more neighbor cells than fit in the neighbor_cells array.
+ *	     Neighbor cells are not parsed if neighbor_cells is NULL.
+ * Returns otherwise a negative error code.
+ */
+int parse_ncellmeas(const char *at_response, struct lte_lc_cells_info *cells,
+		    size_t ncells_max)
+{
+	int err, status;
+	int64_t tmp64;
+	bool incomplete = false;
+	struct ncellmeas_tokenizer t;
+
+	cells->ncells_count = 0;
+	cells->current_cell.id = LTE_LC_CELL_EUTRAN_ID_INVALID;
+
+	if (!ncellmeas_tokenizer_init(&t, at_response)) {
+		/* The unsolicited response is not a NCELLMEAS response, ignore it. */
+		LOG_DBG("Not a valid NCELLMEAS response");
+		return 0;
 	}
 
-	if ((cells->ncells_count == 0) || (cells->neighbor_cells == NULL)) {
-		goto clean_exit;
+	/* Status code. */
+	err = ncellmeas_int_get(&t, 10, &status);
+	if (err) {
+		return err;
 	}
 
-	/* Neighboring cells. */
-	for (size_t i = 0; i < cells->ncells_count; i++) {
-		size_t start_idx = AT_NCELLMEAS_PRE_NCELLS_PARAMS_COUNT +
-				   i * AT_NCELLMEAS_N_PARAMS_COUNT;
+	if (status != AT_NCELLMEAS_STATUS_VALUE_SUCCESS) {
+		return 1;
+	}
 
-		/* EARFCN */
-		err = at_params_int_get(&resp_list,
-					start_idx + AT_NCELLMEAS_N_EARFCN_INDEX,
-					&cells->neighbor_cells[i].earfcn);
-		if (err) {
-			goto clean_exit;
-		}
+	err = ncellmeas_cell_get(&t, &cells->current_cell, false);
+	if (err) {
+		LOG_ERR("Could not parse current cell, error: %d", err);
+		cells->current_cell.id = LTE_LC_CELL_EUTRAN_ID_INVALID;
+		return err;
+	}
 
-		/* Physical cell ID. */
-		err = at_params_short_get(&resp_list,
-					  start_idx + AT_NCELLMEAS_N_PHYS_CELL_ID_INDEX,
-					  &cells->neighbor_cells[i].phys_cell_id);
-		if (err) {
-			goto clean_exit;
-		}
+	cells->current_cell.timing_advance_meas_time = 0;
 
-		/* RSRP */
-		err = at_params_int_get(&resp_list,
-					start_idx + AT_NCELLMEAS_N_RSRP_INDEX,
-					&tmp);
+	/* Neighboring cells. Starting from modem firmware v1.3.1, timing advance
+	 * measurement time information is added as the last parameter in the response,
+	 * which is recognized by it being the only parameter after the last neighbor.
+	 */
+	while (!ncellmeas_tokenizer_done(&t)) {
+		struct lte_lc_ncell ncell;
+
+		err = ncellmeas_int64_get(&t, 10, &tmp64);
 		if (err) {
-			goto clean_exit;
+			return err;
 		}
 
-		cells->neighbor_cells[i].rsrp = tmp;
+		if (ncellmeas_tokenizer_done(&t)) {
+			cells->current_cell.timing_advance_meas_time = tmp64;
+			break;
+		}
 
-		/* RSRQ */
-		err = at_params_int_get(&resp_list,
-					start_idx + AT_NCELLMEAS_N_RSRQ_INDEX,
-					&tmp);
+		err = ncellmeas_ncell_get(&t, tmp64, &ncell);
 		if (err) {
-			goto clean_exit;
+			LOG_ERR("Could not parse neighbor cell, error: %d", err);
+			return err;
 		}
 
-		cells->neighbor_cells[i].rsrq = tmp;
+		if (cells->neighbor_cells == NULL) {
+			continue;
+		}
 
-		/* Time difference. */
-		err = at_params_int_get(&resp_list,
-					start_idx + AT_NCELLMEAS_N_TIME_DIFF_INDEX,
-					&cells->neighbor_cells[i].time_diff);
-		if (err) {
-			goto clean_exit;
+		if (cells->ncells_count >= ncells_max) {
+			incomplete = true;
+			continue;
 		}
-	}
 
-	if (incomplete) {
-		err = -E2BIG;
+		cells->neighbor_cells[cells->ncells_count] = ncell;
+		cells->ncells_count++;
 	}
 
-clean_exit:
-	at_params_list_free(&resp_list);
-
-	return err;
+	return incomplete ? -E2BIG : 0;
 }
 
 int parse_ncellmeas_gci(struct lte_lc_ncellmeas_params *params,
 	const char *at_response, struct lte_lc_cells_info *cells)
 {
-	struct at_param_list resp_list;
-	struct lte_lc_ncell *ncells = NULL;
-	int err, status, tmp_int, len;
-	int16_t tmp_short;
-	char response_prefix[sizeof(AT_NCELLMEAS_RESPONSE_PREFIX)] = {0};
-	size_t response_prefix_len = sizeof(response_prefix);
-	char tmp_str[7];
+	int err, status, tmp_int;
+	int64_t tmp64;
 	bool incomplete = false;
-	int curr_index;
-	size_t i = 0, j = 0, k = 0;
-
-	/* Count the actual number of parameters in the AT response before
-	 * allocating heap for it. This may save quite a bit of heap as the
-	 * worst case scenario is 96 elements.
-	 * 3 is added to account for the parameters that do not have a trailing
-	 * comma.
-	 */
-	size_t param_count = get_char_frequency(at_response, ',') + 3;
+	struct ncellmeas_tokenizer t;
+	size_t i, j;
 
 	/* Fill the defaults */
 	cells->gci_cells_count = 0;
@@ -1032,292 +1093,103 @@ int parse_ncellmeas_gci(struct lte_lc_ncellmeas_params *params,
 	 *	[,<n_earfcn2>,<n_phys_cell_id2>,<n_rsrp2>,<n_rsrq2>,<time_diff2>]...]...
 	 */
 
-	err = at_params_list_init(&resp_list, param_count);
-	if (err) {
-		LOG_ERR("Could not init AT params list for cell_list, error: %d", err);
-		goto clean_exit;
-	}
-
-	err = at_parser_params_from_str(at_response, NULL, &resp_list);
-	if (err && err != -E2BIG) {
-		LOG_ERR("Could not parse AT%%NCELLMEAS response, error: %d", err);
-		goto clean_exit;
-	} else if (err == -E2BIG) {
-		/* Returns -E2BIG if the buffers set by CONFIG_LTE_NEIGHBOR_CELLS_MAX
-		 * are too small for the modem response. The associated data is still valid,
-		 * but not complete.
-		 */
-		incomplete = true;
-		LOG_WRN("E2BIG was returned, continue. param_count %d, err %d, str %s",
-			param_count, err, at_response);
-	}
-
-	err = at_params_string_get(&resp_list,
-				   AT_RESPONSE_PREFIX_INDEX,
-				   response_prefix,
-				   &response_prefix_len);
-	if (err) {
-		LOG_ERR("Could not get response prefix, error: %d", err);
-		goto clean_exit;
-	}
-
-	if (!response_is_valid(response_prefix, response_prefix_len,
-			       AT_NCELLMEAS_RESPONSE_PREFIX)) {
+	if (!ncellmeas_tokenizer_init(&t, at_response)) {
 		/* The unsolicited response is not a NCELLMEAS response, ignore it. */
 		LOG_ERR("Not a valid NCELLMEAS response");
-		goto clean_exit;
+		return 0;
 	}
 
 	/* Status code. */
-	curr_index = AT_NCELLMEAS_STATUS_INDEX;
-	err = at_params_int_get(&resp_list, curr_index, &status);
+	err = ncellmeas_int_get(&t, 10, &status);
 	if (err) {
 		LOG_DBG("Cannot parse NCELLMEAS status");
-		goto clean_exit;
+		return err;
 	}
 
 	if (status != AT_NCELLMEAS_STATUS_VALUE_SUCCESS) {
-		err = 1;
 		LOG_DBG("NCELLMEAS status %d", status);
-		goto clean_exit;
+		return 1;
 	}
 
 	/* Go through the cells. */
-	for (i = 0; curr_index < (param_count - (AT_NCELLMEAS_GCI_CELL_PARAMS_COUNT + 1)) &&
-			i < params->gci_count; i++) {
+	for (i = 0; !ncellmeas_tokenizer_done(&t) && i < params->gci_count; i++) {
 		struct lte_lc_cell parsed_cell;
 		bool is_serving_cell;
-		uint8_t parsed_ncells_count;
-
-		/* <cell_id>  */
-		curr_index++;
-		err = string_param_to_int(&resp_list, curr_index, &tmp_int, 16);
-		if (err) {
-			LOG_ERR("Could not parse cell_id, index %d, i %d error: %d",
-				curr_index, i, err);
-			goto clean_exit;
-		}
-
-		if (tmp_int > LTE_LC_CELL_EUTRAN_ID_MAX) {
-			tmp_int = LTE_LC_CELL_EUTRAN_ID_INVALID;
-		}
-		parsed_cell.id = tmp_int;
-
-		/* <plmn> */
-		len = sizeof(tmp_str);
-
-		curr_index++;
-		err = at_params_string_get(&resp_list, curr_index, tmp_str, &len);
-		if (err) {
-			LOG_ERR("Could not parse plmn, error: %d", err);
-			goto clean_exit;
-		}
-		/* A successful call to `at_params_string_get` guarantees `len` to be set to
-		 * a value lower than the totalt size of `tmp_str`.
-		 */
-		tmp_str[len] = '\0';
-
-		/* Read MNC and store as integer. The MNC starts as the fourth character
-		 * in the string, following three characters long MCC.
-		 */
-		err = string_to_int(&tmp_str[3], 10, &parsed_cell.mnc);
-		if (err) {
-			LOG_ERR("string_to_int, error: %d", err);
-			goto clean_exit;
-		}
-
-		/* Null-terminated MCC, read and store it. */
-		tmp_str[3] = '\0';
-
-		err = string_to_int(tmp_str, 10, &parsed_cell.mcc);
-		if (err) {
-			LOG_ERR("string_to_int, error: %d", err);
-			goto clean_exit;
-		}
-
-		/* <tac> */
-		curr_index++;
-		err = string_param_to_int(&resp_list, curr_index, &tmp_int, 16);
-		if (err) {
-			LOG_ERR("Could not parse tracking_area_code in i %d, error: %d", i, err);
-			goto clean_exit;
-		}
-		parsed_cell.tac = tmp_int;
-
-		/* <ta> */
-		curr_index++;
-		err = at_params_int_get(&resp_list, curr_index, &tmp_int);
-		if (err) {
-			LOG_ERR("Could not parse timing_advance, error: %d", err);
-			goto clean_exit;
-		}
-		parsed_cell.timing_advance = tmp_int;
-
-		/* <ta_meas_time> */
-		curr_index++;
-		err = at_params_int64_get(&resp_list, curr_index,
-					  &parsed_cell.timing_advance_meas_time);
-		if (err) {
-			LOG_ERR("Could not parse timing_advance_meas_time, error: %d", err);
-			goto clean_exit;
-		}
+		int parsed_ncells_count;
 
-		/* <earfcn> */
-		curr_index++;
-		err = at_params_int_get(&resp_list, curr_index, &parsed_cell.earfcn);
+		err = ncellmeas_cell_get(&t, &parsed_cell, true);
 		if (err) {
-			LOG_ERR("Could not parse earfcn, error: %d", err);
-			goto clean_exit;
-		}
-
-		/* <phys_cell_id> */
-		curr_index++;
-		err = at_params_short_get(&resp_list, curr_index, &parsed_cell.phys_cell_id);
-		if (err) {
-			LOG_ERR("Could not parse phys_cell_id, error: %d", err);
-			goto clean_exit;
-		}
-
-		/* <rsrp> */
-		curr_index++;
-		err = at_params_short_get(&resp_list, curr_index, &parsed_cell.rsrp);
-		if (err) {
-			LOG_ERR("Could not parse rsrp, error: %d", err);
-			goto clean_exit;
-		}
-
-		/* <rsrq> */
-		curr_index++;
-		err = at_params_short_get(&resp_list, curr_index, &parsed_cell.rsrq);
-		if (err) {
-			LOG_ERR("Could not parse rsrq, error: %d", err);
-			goto clean_exit;
-		}
-
-		/* <meas_time> */
-		curr_index++;
-		err = at_params_int64_get(&resp_list, curr_index, &parsed_cell.measurement_time);
-		if (err) {
-			LOG_ERR("Could not parse meas_time, error: %d", err);
-			goto clean_exit;
+			LOG_ERR("Could not parse cell %d, error: %d", i, err);
+			return err;
 		}
 
 		/* <serving> */
-		curr_index++;
-		err = at_params_short_get(&resp_list, curr_index, &tmp_short);
+		err = ncellmeas_int_get(&t, 10, &tmp_int);
 		if (err) {
 			LOG_ERR("Could not parse serving, error: %d", err);
-			goto clean_exit;
+			return err;
 		}
-		is_serving_cell = tmp_short;
+		is_serving_cell = tmp_int;
 
 		/* <neighbor_count> */
-		curr_index++;
-		err = at_params_short_get(&resp_list, curr_index, &tmp_short);
+		err = ncellmeas_int_get(&t, 10, &parsed_ncells_count);
+		if (!err && parsed_ncells_count < 0) {
+			err = -EBADMSG;
+		}
 		if (err) {
 			LOG_ERR("Could not parse neighbor_count, error: %d", err);
-			goto clean_exit;
+			return err;
 		}
-		parsed_ncells_count = tmp_short;
-
-		if (is_serving_cell) {
-			int to_be_parsed_ncell_count = 0;
 
+		if (!is_serving_cell) {
+			cells->gci_cells[cells->gci_cells_count] = parsed_cell;
+			cells->gci_cells_count++; /* Increase count for non-serving GCI cell */
+		} else {
 			/* This the current/serving cell.
 			 * In practice the <neighbor_count> is always 0 for other than
 			 * the serving cell, i.e. no neigbour cell list is available.
-			 * Thus, handle neighbor cells only for the serving cell.
 			 */
 			cells->current_cell = parsed_cell;
-			if (parsed_ncells_count != 0) {
-				/* Allocate room for the parsed neighbor info. */
-				if (parsed_ncells_count > CONFIG_LTE_NEIGHBOR_CELLS_MAX) {
-					to_be_parsed_ncell_count = CONFIG_LTE_NEIGHBOR_CELLS_MAX;
-					incomplete = true;
-					LOG_WRN("Cutting response, because received neigbor cell"
-						" count is bigger than configured max: %d",
-							CONFIG_LTE_NEIGHBOR_CELLS_MAX);
-
-				} else {
-					to_be_parsed_ncell_count = parsed_ncells_count;
-				}
-				ncells = k_calloc(
-						to_be_parsed_ncell_count,
-						sizeof(struct lte_lc_ncell));
-				if (ncells == NULL) {
-					LOG_WRN("Failed to allocate memory for the ncells"
-						" (continue)");
-					continue;
-				}
-				cells->neighbor_cells = ncells;
-				cells->ncells_count = to_be_parsed_ncell_count;
+		}
+
+		/* Parse neighbors. Cells that do not fit are skipped so that the
+		 * following GCI cells are still parsed correctly.
+		 */
+		for (j = 0; j < parsed_ncells_count; j++) {
+			struct lte_lc_ncell ncell;
+
+			/* <n_earfcn[j]> */
+			err = ncellmeas_int64_get(&t, 10, &tmp64);
+			if (!err) {
+				err = ncellmeas_ncell_get(&t, tmp64, &ncell);
+			}
+			if (err) {
+				LOG_ERR("Could not parse neighbor cell, error: %d", err);
+				return err;
 			}
 
-			/* Parse neighbors */
-			for (j = 0; j < to_be_parsed_ncell_count; j++) {
-				/* <n_earfcn[j]> */
-				curr_index++;
-				err = at_params_int_get(&resp_list,
-							curr_index,
-							&cells->neighbor_cells[j].earfcn);
-				if (err) {
-					LOG_ERR("Could not parse n_earfcn, error: %d", err);
-					goto clean_exit;
-				}
-
-				/* <n_phys_cell_id[j]> */
-				curr_index++;
-				err = at_params_short_get(&resp_list,
-							  curr_index,
-							  &cells->neighbor_cells[j].phys_cell_id);
-				if (err) {
-					LOG_ERR("Could not parse n_phys_cell_id, error: %d", err);
-					goto clean_exit;
-				}
-
-				/* <n_rsrp[j]> */
-				curr_index++;
-				err = at_params_int_get(&resp_list, curr_index, &tmp_int);
-				if (err) {
-					LOG_ERR("Could not parse n_rsrp, error: %d", err);
-					goto clean_exit;
-				}
-				cells->neighbor_cells[j].rsrp = tmp_int;
-
-				/* <n_rsrq[j]> */
-				curr_index++;
-				err = at_params_int_get(&resp_list, curr_index, &tmp_int);
-				if (err) {
-					LOG_ERR("Could not parse n_rsrq, error: %d", err);
-					goto clean_exit;
-				}
-				cells->neighbor_cells[j].rsrq = tmp_int;
-
-				/* <time_diff[j]> */
-				curr_index++;
-				err = at_params_int_get(&resp_list,
-							curr_index,
-							&cells->neighbor_cells[j].time_diff);
-				if (err) {
-					LOG_ERR("Could not parse time_diff, error: %d", err);
-					goto clean_exit;
-				}
+			if (!is_serving_cell || cells->neighbor_cells == NULL) {
+				continue;
 			}
-		} else {
-			cells->gci_cells[k] = parsed_cell;
-			cells->gci_cells_count++; /* Increase count for non-serving GCI cell */
-			k++;
+
+			if (cells->ncells_count >= CONFIG_LTE_NEIGHBOR_CELLS_MAX) {
+				incomplete = true;
+				continue;
+			}
+
+			cells->neighbor_cells[cells->ncells_count] = ncell;
+			cells->ncells_count++;
 		}
 	}
 
 	if (incomplete) {
-		err = -E2BIG;
+		LOG_WRN("Cutting response, because received neigbor cell"
+			" count is bigger than configured max: %d",
+			CONFIG_LTE_NEIGHBOR_CELLS_MAX);
+		return -E2BIG;
 	}
 
-clean_exit:
-	at_params_list_free(&resp_list);
-
-	return err;
+	return 0;
 }
 
 int parse_xmodemsleep(const char *at_response, struct lte_lc_modem_sleep *modem_sleep)
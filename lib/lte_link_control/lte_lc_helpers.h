@@ -227,33 +227,33 @@ int parse_cereg(const char *at_response,
  */
 int parse_xt3412(const char *at_response, uint64_t *time);
 
-/* @brief Get the number of neighboring cells reported in an NCELLMEAS response.
- *
- * @param at_response Pointer to buffer with AT response to parse.
- *
- * @return The number of neighbor cells found in the response.
- */
-uint32_t neighborcell_count_get(const char *at_response);
-
 /* @brief Parses an NCELLMEAS notification and stores neighboring cell
  *	  information in a struct.
  *
+ * The response is parsed in a single pass without heap allocations.
+ *
  * @param at_response Pointer to buffer with AT response.
- * @param ncell Pointer to ncell structure.
+ * @param cells Pointer to cells structure.
+ * @param ncells_max Number of cells that fit in the neighbor_cells array.
  *
  * @return Zero on success or (negative) error code otherwise.
- *         Returns -E2BIG if the static buffers set by CONFIG_LTE_NEIGHBOR_CELLS_MAX
- *         are to small for the modem response. The associated data is still valid,
- *         but not complete.
+ *         Returns -E2BIG if the response has more than @p ncells_max neighbor cells.
+ *         The associated data is still valid, but not complete.
+ *         Neighbor cells are skipped if cells->neighbor_cells is NULL.
  */
-int parse_ncellmeas(const char *at_response, struct lte_lc_cells_info *cells);
+int parse_ncellmeas(const char *at_response, struct lte_lc_cells_info *cells,
+		    size_t ncells_max);
 
 /* @brief Parses a NCELLMEAS notification for GCI search types, and stores neighboring cell
  *	  and measured GCI cell information in a struct.
  *
+ * The response is parsed in a single pass without heap allocations.
+ *
  * @param params Neighbor cell measurement parameters.
  * @param at_response Pointer to buffer with AT response.
- * @param cells Pointer to lte_lc_cells_info structure.
+ * @param cells Pointer to lte_lc_cells_info structure. The gci_cells array must have
+ *		room for params->gci_count cells and the neighbor_cells array, if not NULL,
+ *		for CONFIG_LTE_NEIGHBOR_CELLS_MAX cells.
  *
  * @return Zero on success or (negative) error code otherwise.
  *         Returns -E2BIG if the static buffers set by CONFIG_LTE_NEIGHBOR_CELLS_MAX
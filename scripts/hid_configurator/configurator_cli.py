@@ -15,6 +15,8 @@ from modules.config import change_config, fetch_config
 from modules.dfu import DfuImage
 from modules.dfu import fwinfo, fwreboot, dfu_transfer
 from modules.led_stream import send_continuous_led_stream
+from modules.latency import fetch_latency
+from modules.latency import print_latency, reset_latency
 try:
     from modules.music_led_stream import send_music_led_stream
 except ImportError as e:
@@ -176,6 +178,22 @@ def perform_led_stream(dev, args):
         send_continuous_led_stream(dev, args.led_id, args.freq)
 
 
+def perform_latency(dev, args):
+    if args.reset:
+        if reset_latency(dev):
+            print('Latency statistics reset')
+        else:
+            print('Latency statistics reset failed')
+        return
+
+    stats = fetch_latency(dev)
+    if stats is None:
+        print('Latency statistics request failed')
+        return
+
+    print_latency(stats)
+
+
 def parse_arguments():
     parser = argparse.ArgumentParser()
 
@@ -204,6 +222,12 @@ def parse_arguments():
     parser_stream.add_argument('freq', type=int, help='Color change frequency (in Hz)')
     parser_stream.add_argument('--file', type=str, help='Selected audio file (*.wav)')
 
+    parser_latency = sp_commands.add_parser('latency',
+                                            help='Show HID report latency statistics')
+    parser_latency.add_argument('--reset',
+                                help='Clear latency statistics',
+                                action='store_true')
+
     assert isinstance(MODULE_CONFIG, dict)
     parser_config = sp_commands.add_parser('config',
                                            help='Configuration option set/fetch')
@@ -274,7 +298,8 @@ configurator.ALLOWED_COMMANDS = {
     'fwinfo' : perform_fwinfo,
     'fwreboot' : perform_fwreboot,
     'config' : perform_config,
-    'led_stream' : perform_led_stream
+    'led_stream' : perform_led_stream,
+    'latency' : perform_latency
 }
 
 
@@ -0,0 +1,57 @@
+#
+# Copyright (c) 2022 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+
+import struct
+
+HID_LATENCY_MODULE = 'hid_latency'
+HID_LATENCY_STAGES = ('dispatch', 'transmit')
+HID_LATENCY_STAGE_FORMAT = '<IIII'
+
+
+def _fetch(dev, module_name, option_name, fmt):
+    success, fetched_data = dev.config_get(module_name, option_name)
+    if not success or fetched_data is None:
+        return None
+
+    if len(fetched_data) < struct.calcsize(fmt):
+        return None
+
+    return struct.unpack_from(fmt, fetched_data)
+
+
+def fetch_latency(dev):
+    """Return latency statistics as a dict of stage name to
+    (count, p50, p99, max) in microseconds, or None on failure."""
+    if dev.get_complete_module_name(HID_LATENCY_MODULE) is None:
+        print('HID latency module not found')
+        return None
+
+    stats = {}
+    for stage in HID_LATENCY_STAGES:
+        res = _fetch(dev, HID_LATENCY_MODULE, stage, HID_LATENCY_STAGE_FORMAT)
+        if res is None:
+            print('Cannot fetch {} latency'.format(stage))
+            return None
+        stats[stage] = res
+
+    return stats
+
+
+def reset_latency(dev):
+    if dev.get_complete_module_name(HID_LATENCY_MODULE) is None:
+        print('HID latency module not found')
+        return False
+
+    return dev.config_set(HID_LATENCY_MODULE, 'reset', None)
+
+
+def print_latency(stats):
+    print('{:<10}{:>10}{:>12}{:>12}{:>12}'.format('stage', 'reports',
+                                                  'p50 [us]', 'p99 [us]',
+                                                  'max [us]'))
+    for stage in HID_LATENCY_STAGES:
+        count, p50, p99, max_us = stats[stage]
+        print('{:<10}{:>10}{:>12}{:>12}{:>12}'.format(stage, count, p50, p99,
+                                                      max_us))
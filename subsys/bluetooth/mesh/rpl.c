@@ -18,10 +18,60 @@
 #include <mesh/rpl.h>
 #include <emds/emds.h>
 
+/* The hash index is kept at most half full to keep the probe sequences short. */
+#define RPL_INDEX_SIZE (2 * CONFIG_BT_MESH_CRPL)
+
+BUILD_ASSERT(CONFIG_BT_MESH_CRPL < UINT16_MAX, "RPL index cannot address all RPL entries");
+
 static struct bt_mesh_rpl replay_list[CONFIG_BT_MESH_CRPL];
 
 EMDS_STATIC_ENTRY_DEFINE(rpl_store, CONFIG_BT_MESH_RPL_INDEX, replay_list, sizeof(replay_list));
 
+/* Open addressing hash index of the replay list, keyed on the source address.
+ * Each element holds the replay list entry index incremented by one, or zero
+ * if the element is empty. Entries are never removed from the replay list one
+ * by one, so the index is only rebuilt when the list is cleared or compacted.
+ * The index is not stored, it is rebuilt from the replay list loaded from the
+ * Emergency Data Storage on first use.
+ */
+static uint16_t rpl_index[RPL_INDEX_SIZE];
+/* Number of occupied replay list entries. Occupied entries are always kept at
+ * the beginning of the replay list.
+ */
+static size_t rpl_cnt;
+static bool rpl_index_valid;
+
+static size_t rpl_index_hash(uint16_t src)
+{
+	return ((uint32_t)src * 2654435761U >> 16) % RPL_INDEX_SIZE;
+}
+
+static uint16_t *rpl_index_find(uint16_t src)
+{
+	size_t i = rpl_index_hash(src);
+
+	while (rpl_index[i] && (replay_list[rpl_index[i] - 1].src != src)) {
+		i = (i + 1) % RPL_INDEX_SIZE;
+	}
+
+	return &rpl_index[i];
+}
+
+static void rpl_index_rebuild(void)
+{
+	(void)memset(rpl_index, 0, sizeof(rpl_index));
+
+	for (rpl_cnt = 0; rpl_cnt < ARRAY_SIZE(replay_list); rpl_cnt++) {
+		if (!replay_list[rpl_cnt].src) {
+			break;
+		}
+
+		*rpl_index_find(replay_list[rpl_cnt].src) = rpl_cnt + 1;
+	}
+
+	rpl_index_valid = true;
+}
+
 void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 		struct bt_mesh_net_rx *rx)
 {
@@ -32,6 +82,18 @@ void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 		rpl->seg = 0;
 	}
 
+	/* A new source is stored in the first empty entry of the replay list.
+	 * If the entry has been taken by another source in the meantime, the
+	 * entry is overwritten and the index is rebuilt on next check.
+	 */
+	if (rpl->src != rx->ctx.addr) {
+		if (!rpl->src && (rpl == &replay_list[rpl_cnt])) {
+			*rpl_index_find(rx->ctx.addr) = ++rpl_cnt;
+		} else {
+			rpl_index_valid = false;
+		}
+	}
+
 	rpl->src = rx->ctx.addr;
 	rpl->seq = rx->seq;
 	rpl->old_iv = rx->old_iv;
@@ -45,7 +107,8 @@ void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 		struct bt_mesh_rpl **match)
 {
-	int i;
+	struct bt_mesh_rpl *rpl;
+	uint16_t *idx;
 
 	/* Don't bother checking messages from ourselves */
 	if (rx->net_if == BT_MESH_NET_IF_LOCAL) {
@@ -57,48 +120,55 @@ bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 		return false;
 	}
 
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		struct bt_mesh_rpl *rpl = &replay_list[i];
+	if (!rpl_index_valid) {
+		rpl_index_rebuild();
+	}
 
-		/* Empty slot */
-		if (!rpl->src) {
-			if (match) {
-				*match = rpl;
-			} else {
-				bt_mesh_rpl_update(rpl, rx);
-			}
+	idx = rpl_index_find(rx->ctx.addr);
 
-			return false;
+	/* No slot for given address */
+	if (!*idx) {
+		if (rpl_cnt == ARRAY_SIZE(replay_list)) {
+			BT_ERR("RPL is full!");
+			return true;
 		}
 
-		/* Existing slot for given address */
-		if (rpl->src == rx->ctx.addr) {
-			if (rx->old_iv && !rpl->old_iv) {
-				return true;
-			}
+		rpl = &replay_list[rpl_cnt];
 
-			if ((!rx->old_iv && rpl->old_iv) ||
-			    rpl->seq < rx->seq) {
-				if (match) {
-					*match = rpl;
-				} else {
-					bt_mesh_rpl_update(rpl, rx);
-				}
+		if (match) {
+			*match = rpl;
+		} else {
+			bt_mesh_rpl_update(rpl, rx);
+		}
 
-				return false;
-			} else {
-				return true;
-			}
+		return false;
+	}
+
+	/* Existing slot for given address */
+	rpl = &replay_list[*idx - 1];
+
+	if (rx->old_iv && !rpl->old_iv) {
+		return true;
+	}
+
+	if ((!rx->old_iv && rpl->old_iv) ||
+	    rpl->seq < rx->seq) {
+		if (match) {
+			*match = rpl;
+		} else {
+			bt_mesh_rpl_update(rpl, rx);
 		}
+
+		return false;
 	}
 
-	BT_ERR("RPL is full!");
 	return true;
 }
 
 void bt_mesh_rpl_clear(void)
 {
 	(void)memset(replay_list, 0, sizeof(replay_list));
+	rpl_index_rebuild();
 }
 
 void bt_mesh_rpl_reset(void)
@@ -130,6 +200,8 @@ void bt_mesh_rpl_reset(void)
 	}
 
 	(void) memset(&replay_list[last - shift + 1], 0, sizeof(struct bt_mesh_rpl) * shift);
+
+	rpl_index_rebuild();
 }
 
 void bt_mesh_rpl_pending_store(uint16_t addr)
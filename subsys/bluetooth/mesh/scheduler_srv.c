@@ -67,26 +67,46 @@ static bool is_entry_defined(struct bt_mesh_scheduler_srv *srv, uint8_t idx)
 	return srv->sch_reg[idx].action != BT_MESH_SCHEDULER_NO_ACTIONS;
 }
 
+static bool is_entry_schedulable(struct bt_mesh_scheduler_srv *srv, uint8_t idx)
+{
+	return srv->sch_reg[idx].action < BT_MESH_SCHEDULER_SCENE_RECALL ||
+	       (srv->sch_reg[idx].action == BT_MESH_SCHEDULER_SCENE_RECALL &&
+		srv->sch_reg[idx].scene_number != 0);
+}
+
 static int get_days_in_month(int year, int month)
 {
-	int days[12] = {31, is_leap_year(year) ? 29 : 28,
+	static const uint8_t days[12] = {31, FEB_DAYS,
 		31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
 
+	if (month == 1 && is_leap_year(year)) {
+		return FEB_LEAP_DAYS;
+	}
+
 	return days[month];
 }
 
+/* Number of leap years in [1, year). */
+static int leap_years_before(int year)
+{
+	year--;
+	return year / 4 - year / 100 + year / 400;
+}
+
 static int get_day_of_week(int year, int month, int day)
 {
-	int day_cnt = 0;
+	static const uint16_t days_before_month[12] = {
+		0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334
+	};
+	int day_cnt = year * (int)DAYS_YEAR;
 
 	year += TM_START_YEAR;
 
-	for (int i = TM_START_YEAR; i < year; i++) {
-		day_cnt += is_leap_year(i) ? DAYS_LEAP_YEAR : DAYS_YEAR;
-	}
+	day_cnt += leap_years_before(year) - leap_years_before(TM_START_YEAR);
+	day_cnt += days_before_month[month];
 
-	for (int i = 0; i < month; i++) {
-		day_cnt += get_days_in_month(year, i);
+	if (month > 1 && is_leap_year(year)) {
+		day_cnt++;
 	}
 
 	day_cnt += day;
@@ -151,18 +171,18 @@ static int day_handler(struct tm *sched_time, struct tm *current_local,
 
 		sched_time->tm_mday = info->start_day;
 	} else {
-		entry->day = MIN(entry->day,
+		sched_time->tm_mday = MIN(entry->day,
 			get_days_in_month(sched_time->tm_year + TM_START_YEAR,
 					sched_time->tm_mon));
 
-		sched_time->tm_mday = entry->day;
-		if (sched_time->tm_mday < current_local->tm_mday) {
+		if (info->consider_ovflw &&
+		    sched_time->tm_mday < info->start_day) {
 			day_ovflw = true;
 		}
 	}
 
-	if (day_ovflw && info->consider_ovflw) {
-		info->start_month++;
+	if (day_ovflw) {
+		info->start_month = sched_time->tm_mon + 1;
 		return MONTH_STAGE;
 	}
 
@@ -187,8 +207,9 @@ static int day_handler(struct tm *sched_time, struct tm *current_local,
 		}
 	}
 
-	if (day_ovflw && info->consider_ovflw) {
-		info->start_month++;
+	/* The month has no matching day, continue with the next one. */
+	if (day_ovflw) {
+		info->start_month = sched_time->tm_mon + 1;
 		return MONTH_STAGE;
 	}
 
@@ -419,31 +440,12 @@ static void run_scheduler(struct bt_mesh_scheduler_srv *srv)
 			scheduled_uptime, current_uptime);
 }
 
-static void schedule_action(struct bt_mesh_scheduler_srv *srv,
-			    uint8_t idx)
+static void schedule_entry(struct bt_mesh_scheduler_srv *srv, uint8_t idx,
+			   struct tm *current_local)
 {
 	struct tm sched_time = {0};
 	struct bt_mesh_schedule_entry *entry = &srv->sch_reg[idx];
 
-	int64_t current_uptime = k_uptime_get();
-	struct tm *current_local = bt_mesh_time_srv_localtime(srv->time_srv,
-			current_uptime);
-
-	if (current_local == NULL) {
-		BT_WARN("Local time not available");
-		return;
-	}
-
-	BT_DBG("Current uptime %lld", current_uptime);
-
-	BT_DBG("Current time:");
-	BT_DBG("        year: %d", current_local->tm_year);
-	BT_DBG("       month: %d", current_local->tm_mon);
-	BT_DBG("         day: %d", current_local->tm_mday);
-	BT_DBG("        hour: %d", current_local->tm_hour);
-	BT_DBG("      minute: %d", current_local->tm_min);
-	BT_DBG("      second: %d", current_local->tm_sec);
-
 	if (!convert_scheduler_time_to_tm(&sched_time, current_local, entry)) {
 		BT_WARN("Cannot convert scheduled action time to struct tm");
 		return;
@@ -465,6 +467,43 @@ static void schedule_action(struct bt_mesh_scheduler_srv *srv,
 	WRITE_BIT(srv->active_bitmap, idx, 1);
 }
 
+static bool current_local_get(struct bt_mesh_scheduler_srv *srv,
+			      struct tm *current_local)
+{
+	int64_t current_uptime = k_uptime_get();
+	struct tm *local = bt_mesh_time_srv_localtime(srv->time_srv,
+			current_uptime);
+
+	if (local == NULL) {
+		BT_WARN("Local time not available");
+		return false;
+	}
+
+	*current_local = *local;
+
+	BT_DBG("Current uptime %lld", current_uptime);
+
+	BT_DBG("Current time:");
+	BT_DBG("        year: %d", current_local->tm_year);
+	BT_DBG("       month: %d", current_local->tm_mon);
+	BT_DBG("         day: %d", current_local->tm_mday);
+	BT_DBG("        hour: %d", current_local->tm_hour);
+	BT_DBG("      minute: %d", current_local->tm_min);
+	BT_DBG("      second: %d", current_local->tm_sec);
+
+	return true;
+}
+
+static void schedule_action(struct bt_mesh_scheduler_srv *srv,
+			    uint8_t idx)
+{
+	struct tm current_local;
+
+	if (current_local_get(srv, &current_local)) {
+		schedule_entry(srv, idx, &current_local);
+	}
+}
+
 static void scheduled_action_handle(struct k_work *work)
 {
 	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
@@ -642,13 +681,18 @@ static int action_set(struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
 	srv->sch_reg[idx] = tmp;
 	BT_DBG("Rx: scheduler server action index %d set, ack %d", idx, ack);
 
-	if (srv->sch_reg[idx].action < BT_MESH_SCHEDULER_SCENE_RECALL ||
-	   (srv->sch_reg[idx].action == BT_MESH_SCHEDULER_SCENE_RECALL &&
-	    srv->sch_reg[idx].scene_number != 0)) {
+	WRITE_BIT(srv->active_bitmap, idx, 0);
+	if (srv->idx == idx) {
+		/* The pending timer belongs to the old entry. */
+		srv->idx = BT_MESH_SCHEDULER_ACTION_ENTRY_COUNT;
+	}
+
+	if (is_entry_schedulable(srv, idx)) {
 		schedule_action(srv, idx);
-		run_scheduler(srv);
 	}
 
+	run_scheduler(srv);
+
 	if (srv->action_set_cb) {
 		srv->action_set_cb(srv, ctx, idx, &srv->sch_reg[idx]);
 	}
@@ -835,12 +879,27 @@ const struct bt_mesh_model_cb _bt_mesh_scheduler_setup_srv_cb = {
 
 int bt_mesh_scheduler_srv_time_update(struct bt_mesh_scheduler_srv *srv)
 {
+	struct tm current_local;
+
 	if (srv == NULL) {
 		return -EINVAL;
 	}
 
+	if (!current_local_get(srv, &current_local)) {
+		return 0;
+	}
+
+	/* Each entry only needs its next occurrence recomputed against the new
+	 * local time; run_scheduler() then picks the earliest cached one.
+	 */
+	srv->idx = BT_MESH_SCHEDULER_ACTION_ENTRY_COUNT;
+
 	for (int idx = 0; idx < BT_MESH_SCHEDULER_ACTION_ENTRY_COUNT; ++idx) {
-		schedule_action(srv, idx);
+		WRITE_BIT(srv->active_bitmap, idx, 0);
+
+		if (is_entry_schedulable(srv, idx)) {
+			schedule_entry(srv, idx, &current_local);
+		}
 	}
 
 	run_scheduler(srv);
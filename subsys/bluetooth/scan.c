@@ -764,43 +764,21 @@ static int scan_short_name_filter_add(const struct bt_scan_short_name *short_nam
 	return 0;
 }
 
-static bool find_uuid(const uint8_t *data,
-		      uint8_t data_len,
-		      uint8_t uuid_type,
-		      const struct bt_scan_uuid *target_uuid)
+static uint8_t uuid_type_len(uint8_t uuid_type)
 {
-	uint8_t uuid_len;
-
 	switch (uuid_type) {
 	case BT_UUID_TYPE_16:
-		uuid_len = sizeof(uint16_t);
-		break;
+		return sizeof(uint16_t);
 
 	case BT_UUID_TYPE_32:
-		uuid_len = sizeof(uint32_t);
-		break;
+		return sizeof(uint32_t);
 
 	case BT_UUID_TYPE_128:
-		uuid_len = BT_SCAN_UUID_128_SIZE * sizeof(uint8_t);
-		break;
+		return BT_SCAN_UUID_128_SIZE * sizeof(uint8_t);
 
 	default:
-		return false;
-	}
-
-	for (size_t i = 0; i < data_len; i += uuid_len) {
-		struct bt_uuid_128 uuid;
-
-		if (!bt_uuid_create(&uuid.uuid, &data[i], uuid_len)) {
-			return false;
-		}
-
-		if (bt_uuid_cmp(&uuid.uuid, target_uuid->uuid) == 0) {
-			return true;
-		}
+		return 0;
 	}
-
-	return false;
 }
 
 static bool adv_uuid_compare(const struct bt_data *data, uint8_t uuid_type,
@@ -810,13 +788,36 @@ static bool adv_uuid_compare(const struct bt_data *data, uint8_t uuid_type,
 			&bt_scan.scan_filters.uuid;
 	const bool all_filters_mode = bt_scan.scan_filters.all_mode;
 	const uint8_t counter = bt_scan.scan_filters.uuid.cnt;
+	const uint8_t uuid_len = uuid_type_len(uuid_type);
 	uint8_t data_len = data->data_len;
 	uint8_t uuid_match_cnt = 0;
+	bool found[MAX(CONFIG_BT_SCAN_UUID_CNT, 1)] = {false};
+
+	if (uuid_len == 0) {
+		return false;
+	}
+
+	/* Decode each advertised UUID only once and compare it
+	 * with all of the UUID filters.
+	 */
+	for (size_t i = 0; (i + uuid_len) <= data_len; i += uuid_len) {
+		struct bt_uuid_128 uuid;
+
+		if (!bt_uuid_create(&uuid.uuid, &data->data[i], uuid_len)) {
+			break;
+		}
+
+		for (size_t j = 0; j < counter; j++) {
+			if (!found[j] &&
+			    (bt_uuid_cmp(&uuid.uuid, uuid_filter->uuid[j].uuid) == 0)) {
+				found[j] = true;
+			}
+		}
+	}
 
 	for (size_t i = 0; i < counter; i++) {
 
-		if (find_uuid(data->data, data_len, uuid_type,
-			      &uuid_filter->uuid[i])) {
+		if (found[i]) {
 			control->filter_status.uuid.uuid[uuid_match_cnt] =
 				uuid_filter->uuid[i].uuid;
 
@@ -1378,6 +1379,13 @@ void bt_scan_update_init_conn_params(struct bt_le_conn_param *new_conn_param)
 	bt_scan.conn_param = *new_conn_param;
 }
 
+static bool is_adv_data_filter_enabled(void)
+{
+	return is_name_filter_enabled() || is_short_name_filter_enabled() ||
+	       is_uuid_filter_enabled() || is_appearance_filter_enabled() ||
+	       is_manufacturer_data_filter_enabled();
+}
+
 static void check_enabled_filters(struct bt_scan_control *control)
 {
 	control->filter_cnt = 0;
@@ -1460,10 +1468,6 @@ static bool adv_data_found(struct bt_data *data, void *user_data)
 static void filter_state_check(struct bt_scan_control *control,
 			       const bt_addr_le_t *addr)
 {
-	if (!scan_device_filter_check(addr)) {
-		return;
-	}
-
 	if (control->all_mode &&
 	    (control->filter_match_cnt == control->filter_cnt)) {
 		notify_filter_matched(&control->device_info,
@@ -1496,6 +1500,14 @@ static void scan_recv(const struct bt_le_scan_recv_info *info,
 	struct bt_scan_control scan_control;
 	struct net_buf_simple_state state;
 
+	/* Devices rejected by the blocklist or the connection attempts
+	 * filter are not reported, so there is no need to parse their
+	 * advertising data.
+	 */
+	if (!scan_device_filter_check(info->addr)) {
+		return;
+	}
+
 	memset(&scan_control, 0, sizeof(scan_control));
 
 	scan_control.all_mode = bt_scan.scan_filters.all_mode;
@@ -1511,10 +1523,14 @@ static void scan_recv(const struct bt_le_scan_recv_info *info,
 
 	/* Save advertising buffer state to transfer it
 	 * data to application if futher processing is needed.
+	 * The advertising data is parsed only if at least one of the
+	 * filters depends on it.
 	 */
-	net_buf_simple_save(ad, &state);
-	bt_data_parse(ad, adv_data_found, (void *)&scan_control);
-	net_buf_simple_restore(ad, &state);
+	if (is_adv_data_filter_enabled()) {
+		net_buf_simple_save(ad, &state);
+		bt_data_parse(ad, adv_data_found, (void *)&scan_control);
+		net_buf_simple_restore(ad, &state);
+	}
 
 	scan_control.device_info.recv_info = info;
 	scan_control.device_info.conn_param = &bt_scan.conn_param;
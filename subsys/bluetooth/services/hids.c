@@ -1025,9 +1025,23 @@ static void store_input_report(struct bt_hids_inp_rep *hids_inp_rep,
 
 	const uint8_t *rep_mask = hids_inp_rep->rep_mask;
 
-	for (size_t i = 0; i < len; i++) {
-		if ((rep_mask[i / 8] & BIT(i % 8)) != 0) {
-			rep_data[i] = rep[i];
+	/* Each mask byte covers eight report bytes. Fully set and fully
+	 * cleared mask bytes are the common case, so handle them without
+	 * testing every bit.
+	 */
+	for (size_t i = 0; i < len; i += 8) {
+		size_t chunk = MIN(8, len - i);
+		uint8_t full = BIT_MASK(chunk);
+		uint8_t mask = rep_mask[i / 8] & full;
+
+		if (mask == full) {
+			memcpy(&rep_data[i], &rep[i], chunk);
+		} else if (mask) {
+			for (size_t j = 0; j < chunk; j++) {
+				if ((mask & BIT(j)) != 0) {
+					rep_data[i + j] = rep[i + j];
+				}
+			}
 		}
 	}
 }
@@ -1042,6 +1056,14 @@ static int inp_rep_notify_all(struct bt_hids *hids_obj,
 	struct bt_gatt_attr *rep_attr =
 		&hids_obj->gp.svc.attrs[hids_inp_rep->att_ind];
 
+	/* The CCC value is the highest configuration of all peers, so it is
+	 * zero only when no peer has subscribed. A peer with indications
+	 * enabled hides the notification subscriptions of the others.
+	 */
+	if (!hids_inp_rep->ccc.value) {
+		return -ENODATA;
+	}
+
 	const size_t contexts =
 	    bt_conn_ctx_count(hids_obj->conn_ctx);
 
@@ -1141,6 +1163,10 @@ static int boot_mouse_inp_report_notify_all(
 	uint8_t *rep_data = NULL;
 	uint8_t rep_buff[BT_HIDS_BOOT_MOUSE_REP_LEN] = {0};
 
+	if (!boot_mouse_inp_rep->ccc.value) {
+		return -ENODATA;
+	}
+
 	rep_buff[1] = (uint8_t)x_delta;
 	rep_buff[2] = (uint8_t)y_delta;
 
@@ -1258,6 +1284,10 @@ boot_kb_inp_notify_all(struct bt_hids *hids_obj, uint8_t const *rep,
 	struct bt_gatt_attr *rep_attr = &hids_obj->gp.svc.attrs[rep_ind];
 	uint8_t *rep_data = NULL;
 
+	if (!boot_kb_inp_rep->ccc.value) {
+		return -ENODATA;
+	}
+
 	const size_t contexts = bt_conn_ctx_count(hids_obj->conn_ctx);
 
 	for (size_t i = 0; i < contexts; i++) {
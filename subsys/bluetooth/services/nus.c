@@ -4,9 +4,12 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 
+#include <string.h>
 #include <zephyr/bluetooth/conn.h>
 #include <zephyr/bluetooth/uuid.h>
 #include <zephyr/bluetooth/gatt.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/ring_buffer.h>
 
 #include <bluetooth/services/nus.h>
 #include <zephyr/logging/log.h>
@@ -111,3 +114,173 @@ int bt_nus_send(struct bt_conn *conn, const uint8_t *data, uint16_t len)
 		return -EINVAL;
 	}
 }
+
+#if defined(CONFIG_BT_NUS_STREAM)
+/* Delay before retrying when the stack is out of buffers and no
+ * notification is in flight to trigger the next attempt.
+ */
+#define STREAM_RETRY_DELAY K_MSEC(10)
+
+RING_BUF_DECLARE(stream_rb, CONFIG_BT_NUS_STREAM_BUF_SIZE);
+
+/* Protects the ring buffer, the connection and the statistics. */
+static K_MUTEX_DEFINE(stream_lock);
+static struct bt_conn *stream_conn;
+static atomic_t stream_in_flight;
+static int64_t stream_start;
+static struct bt_nus_stream_stats stream_stats;
+
+static void stream_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(stream_work, stream_work_handler);
+
+static void stream_sent(struct bt_conn *conn, void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	/* Each completed notification returns a credit. */
+	if (atomic_get(&stream_in_flight) > 0) {
+		atomic_dec(&stream_in_flight);
+	}
+
+	k_work_reschedule(&stream_work, K_NO_WAIT);
+}
+
+static void stream_work_handler(struct k_work *work)
+{
+	const struct bt_gatt_attr *attr = &nus_svc.attrs[2];
+	struct bt_gatt_notify_params params = {
+		.attr = attr,
+		.func = stream_sent,
+	};
+	uint32_t mtu;
+	int err;
+
+	k_mutex_lock(&stream_lock, K_FOREVER);
+
+	if (!stream_conn || !bt_gatt_is_subscribed(stream_conn, attr, BT_GATT_CCC_NOTIFY)) {
+		goto unlock;
+	}
+
+	mtu = bt_nus_get_mtu(stream_conn);
+
+	while (atomic_get(&stream_in_flight) < CONFIG_BT_NUS_STREAM_PIPELINE_COUNT) {
+		uint8_t *data;
+		uint32_t len = ring_buf_get_claim(&stream_rb, &data, mtu);
+
+		if (!len) {
+			break;
+		}
+
+		/* The notification data is copied by the stack, so the ring
+		 * buffer space can be released right away.
+		 */
+		params.data = data;
+		params.len = len;
+
+		err = bt_gatt_notify_cb(stream_conn, &params);
+		if (err) {
+			ring_buf_get_finish(&stream_rb, 0);
+
+			if ((err != -ENOMEM) && (err != -ENOBUFS)) {
+				LOG_WRN("Stream notification failed, err %d", err);
+			} else if (!atomic_get(&stream_in_flight)) {
+				k_work_reschedule(&stream_work, STREAM_RETRY_DELAY);
+			}
+
+			break;
+		}
+
+		ring_buf_get_finish(&stream_rb, len);
+		atomic_inc(&stream_in_flight);
+
+		stream_stats.tx_bytes += len;
+		stream_stats.tx_notifications++;
+	}
+
+unlock:
+	k_mutex_unlock(&stream_lock);
+}
+
+static void stream_disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	k_mutex_lock(&stream_lock, K_FOREVER);
+
+	if (conn == stream_conn) {
+		LOG_DBG("Stream closed, %u bytes dropped", ring_buf_size_get(&stream_rb));
+
+		bt_conn_unref(stream_conn);
+		stream_conn = NULL;
+		ring_buf_reset(&stream_rb);
+		atomic_set(&stream_in_flight, 0);
+	}
+
+	k_mutex_unlock(&stream_lock);
+}
+
+BT_CONN_CB_DEFINE(nus_conn_callbacks) = {
+	.disconnected = stream_disconnected,
+};
+
+int bt_nus_stream_send(struct bt_conn *conn, const uint8_t *data, size_t len)
+{
+	const struct bt_gatt_attr *attr = &nus_svc.attrs[2];
+	uint32_t backlog;
+	uint32_t put;
+
+	if (!conn || !data) {
+		return -EINVAL;
+	}
+
+	if (!bt_gatt_is_subscribed(conn, attr, BT_GATT_CCC_NOTIFY)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&stream_lock, K_FOREVER);
+
+	if (!stream_conn) {
+		stream_conn = bt_conn_ref(conn);
+		stream_start = k_uptime_get();
+		memset(&stream_stats, 0, sizeof(stream_stats));
+	} else if (stream_conn != conn) {
+		k_mutex_unlock(&stream_lock);
+		return -EBUSY;
+	}
+
+	put = ring_buf_put(&stream_rb, data, len);
+
+	backlog = ring_buf_size_get(&stream_rb);
+	stream_stats.backlog_peak = MAX(stream_stats.backlog_peak, backlog);
+
+	k_mutex_unlock(&stream_lock);
+
+	if (put) {
+		k_work_reschedule(&stream_work, K_NO_WAIT);
+	}
+
+	return put;
+}
+
+int bt_nus_stream_stats_get(struct bt_nus_stream_stats *stats)
+{
+	int64_t elapsed;
+
+	if (!stats) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&stream_lock, K_FOREVER);
+
+	*stats = stream_stats;
+	stats->backlog = ring_buf_size_get(&stream_rb);
+
+	elapsed = k_uptime_get() - stream_start;
+	if (stream_conn && (elapsed > 0)) {
+		stats->throughput = (uint32_t)((uint64_t)stream_stats.tx_bytes *
+					       MSEC_PER_SEC / elapsed);
+	}
+
+	k_mutex_unlock(&stream_lock);
+
+	return 0;
+}
+#endif /* CONFIG_BT_NUS_STREAM */
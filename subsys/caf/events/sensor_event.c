@@ -40,6 +40,36 @@ APP_EVENT_TYPE_DEFINE(sensor_event,
 			IF_ENABLED(CONFIG_CAF_INIT_LOG_SENSOR_EVENTS,
 				(APP_EVENT_TYPE_FLAGS_INIT_LOG_ENABLE))));
 
+static void log_sensor_batch_event(const struct app_event_header *aeh)
+{
+	const struct sensor_batch_event *event = cast_sensor_batch_event(aeh);
+
+	APP_EVENT_MANAGER_LOG(aeh, "%s samples:%u jitter max:%uus avg:%uus", event->descr,
+			      (unsigned int)event->sample_cnt, (unsigned int)event->jitter_max,
+			      (unsigned int)event->jitter_avg);
+}
+
+static void profile_sensor_batch_event(struct log_event_buf *buf,
+				       const struct app_event_header *aeh)
+{
+	const struct sensor_batch_event *event = cast_sensor_batch_event(aeh);
+
+	nrf_profiler_log_encode_uint8(buf, event->sample_cnt);
+	nrf_profiler_log_encode_uint32(buf, event->jitter_max);
+}
+
+APP_EVENT_INFO_DEFINE(sensor_batch_event,
+		  ENCODE(NRF_PROFILER_ARG_U8, NRF_PROFILER_ARG_U32),
+		  ENCODE("sample_cnt", "jitter_max"),
+		  profile_sensor_batch_event);
+
+APP_EVENT_TYPE_DEFINE(sensor_batch_event,
+		  log_sensor_batch_event,
+		  &sensor_batch_event_info,
+		  APP_EVENT_FLAGS_CREATE(
+			IF_ENABLED(CONFIG_CAF_INIT_LOG_SENSOR_EVENTS,
+				(APP_EVENT_TYPE_FLAGS_INIT_LOG_ENABLE))));
+
 
 static void log_sensor_state_event(const struct app_event_header *aeh)
 {
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 
+#include <stdlib.h>
 #include <zephyr/kernel.h>
 #include <zephyr/drivers/sensor.h>
 #include <zephyr/pm/device.h>
@@ -31,6 +32,13 @@ struct sensor_data {
 	atomic_t state;
 	unsigned int sleep_cntd;
 	atomic_t event_cnt;
+	uint32_t *batch;
+	uint8_t batch_cnt;
+	int64_t batch_start;
+	int64_t last_sample_time;
+	uint32_t jitter_max;
+	uint64_t jitter_sum;
+	uint8_t jitter_cnt;
 };
 
 static struct sensor_data sensor_data[ARRAY_SIZE(sensor_configs)];
@@ -67,6 +75,74 @@ static void send_sensor_event(const char *descr, const struct sensor_value *data
 	APP_EVENT_SUBMIT(event);
 }
 
+static void send_sensor_batch_event(const struct sm_sensor_config *sc, struct sensor_data *sd,
+				    size_t value_cnt)
+{
+	size_t size = sizeof(uint32_t) * sensor_batch_sample_word_cnt(value_cnt) * sd->batch_cnt;
+	struct sensor_batch_event *event = new_sensor_batch_event(size);
+
+	event->descr = sc->event_descr;
+	event->timestamp = sd->batch_start;
+	event->sample_cnt = sd->batch_cnt;
+	event->value_cnt = value_cnt;
+	event->jitter_max = sd->jitter_max;
+	event->jitter_avg = (sd->jitter_cnt > 0) ? (sd->jitter_sum / sd->jitter_cnt) : 0;
+
+	memcpy(event->dyndata.data, sd->batch, size);
+
+	atomic_inc(&sd->event_cnt);
+	APP_EVENT_SUBMIT(event);
+}
+
+static void reset_sensor_batch(struct sensor_data *sd)
+{
+	sd->batch_cnt = 0;
+	sd->jitter_max = 0;
+	sd->jitter_sum = 0;
+	sd->jitter_cnt = 0;
+}
+
+static void add_batch_sample(const struct sm_sensor_config *sc, struct sensor_data *sd,
+			     const struct sensor_value *data, size_t data_cnt, int64_t sample_time)
+{
+	size_t word_cnt = sensor_batch_sample_word_cnt(data_cnt);
+	uint32_t *sample = &sd->batch[sd->batch_cnt * word_cnt];
+
+	if (sd->batch_cnt == 0) {
+		sd->batch_start = sample_time;
+	}
+
+	/* Interval to the previous sample is not measured after the sensor wakes up. */
+	if (sd->last_sample_time >= 0) {
+		int64_t period = (int64_t)sd->sampling_period * USEC_PER_MSEC;
+		uint32_t jitter = llabs((sample_time - sd->last_sample_time) - period);
+
+		sd->jitter_max = MAX(sd->jitter_max, jitter);
+		sd->jitter_sum += jitter;
+		sd->jitter_cnt++;
+	}
+	sd->last_sample_time = sample_time;
+
+	sample[0] = sample_time - sd->batch_start;
+	for (size_t i = 0; i < data_cnt; i++) {
+		sample[i + 1] = sensor_value_to_batch_val(data[i]);
+	}
+	sd->batch_cnt++;
+
+	if (sd->batch_cnt < sc->batch_size) {
+		return;
+	}
+
+	if (atomic_get(&sd->event_cnt) < sc->active_events_limit) {
+		send_sensor_batch_event(sc, sd, data_cnt);
+	} else {
+		LOG_WRN("Did not send batch due to too many active events on sensor: %s",
+			sc->dev->name);
+	}
+
+	reset_sensor_batch(sd);
+}
+
 static struct sensor_data *get_sensor_data(const struct device *dev)
 {
 	for (size_t i = 0; i < ARRAY_SIZE(sensor_configs); i++) {
@@ -168,6 +244,8 @@ static bool is_sensor_active(const struct sensor_data *sd)
 static void sensor_wake_up_post(const struct sm_sensor_config *sc, struct sensor_data *sd)
 {
 	sd->sample_timeout = k_uptime_get();
+	sd->last_sample_time = -1;
+	reset_sensor_batch(sd);
 	if (sc->trigger) {
 		reset_sensor_sleep_cnt(sc, sd);
 	}
@@ -222,6 +300,7 @@ static void sample_sensor(struct sensor_data *sd, const struct sm_sensor_config
 	struct sensor_value data[data_cnt];
 
 	int err = sensor_sample_fetch(sc->dev);
+	int64_t sample_time = k_ticks_to_us_floor64(k_uptime_ticks());
 
 	for (size_t i = 0; !err && (i < sc->chan_cnt); i++) {
 		const struct sm_sampled_channel *sampled_chan = &sc->chans[i];
@@ -234,7 +313,9 @@ static void sample_sensor(struct sensor_data *sd, const struct sm_sensor_config
 		LOG_ERR("Sensor sampling error (err %d)", err);
 		update_sensor_state(sc, sd, SENSOR_STATE_ERROR);
 	} else {
-		if (atomic_get(&sd->event_cnt) < sc->active_events_limit) {
+		if (sd->batch) {
+			add_batch_sample(sc, sd, data, ARRAY_SIZE(data), sample_time);
+		} else if (atomic_get(&sd->event_cnt) < sc->active_events_limit) {
 			send_sensor_event(sc->event_descr, data, ARRAY_SIZE(data),
 					  &sd->event_cnt);
 		} else {
@@ -324,6 +405,25 @@ static int sensor_trigger_init(const struct sm_sensor_config *sc, struct sensor_
 	return 0;
 }
 
+static int sensor_batch_init(const struct sm_sensor_config *sc, struct sensor_data *sd)
+{
+	size_t word_cnt = sensor_batch_sample_word_cnt(get_sensor_data_cnt(sc));
+
+	sd->batch = k_malloc(sc->batch_size * word_cnt * sizeof(uint32_t));
+
+	if (!sd->batch) {
+		LOG_ERR("Failed to allocate memory");
+		__ASSERT_NO_MSG(false);
+		return -ENOMEM;
+	}
+
+	sd->last_sample_time = -1;
+	reset_sensor_batch(sd);
+
+	LOG_INF("Batching configured (%d samples)", sc->batch_size);
+	return 0;
+}
+
 static void configure_max_power_state(void)
 {
 	if (IS_ENABLED(CONFIG_CAF_SENSOR_MANAGER_ACTIVE_PM)) {
@@ -400,6 +500,16 @@ static size_t sensor_init(void)
 			}
 		}
 
+		if (sc->batch_size > 1) {
+			int err = sensor_batch_init(sc, sd);
+
+			if (err) {
+				update_sensor_state(sc, sd, SENSOR_STATE_ERROR);
+				LOG_ERR("%s sensor cannot initialize batching", sc->dev->name);
+				continue;
+			}
+		}
+
 		update_sensor_state(sc, sd, SENSOR_STATE_ACTIVE);
 		alive_sensors++;
 	}
@@ -507,12 +617,10 @@ static bool handle_wake_up_event(const struct app_event_header *aeh)
 	return false;
 }
 
-static bool handle_sensor_event(const struct app_event_header *aeh)
+static bool handle_sensor_event(const char *descr)
 {
-	const struct sensor_event *event = cast_sensor_event(aeh);
-
 	for (size_t i = 0; i < ARRAY_SIZE(sensor_configs); i++) {
-		if (event->descr == sensor_configs[i].event_descr) {
+		if (descr == sensor_configs[i].event_descr) {
 			struct sensor_data *sd = &sensor_data[i];
 
 			atomic_dec(&sd->event_cnt);
@@ -564,7 +672,11 @@ static bool app_event_handler(const struct app_event_header *aeh)
 	}
 
 	if (is_sensor_event(aeh)) {
-		return handle_sensor_event(aeh);
+		return handle_sensor_event(cast_sensor_event(aeh)->descr);
+	}
+
+	if (is_sensor_batch_event(aeh)) {
+		return handle_sensor_event(cast_sensor_batch_event(aeh)->descr);
 	}
 
 	if (is_set_sensor_period_event(aeh)) {
@@ -589,6 +701,7 @@ APP_EVENT_LISTENER(MODULE, app_event_handler);
 APP_EVENT_SUBSCRIBE(MODULE, module_state_event);
 APP_EVENT_SUBSCRIBE(MODULE, set_sensor_period_event);
 APP_EVENT_SUBSCRIBE_FINAL(MODULE, sensor_event);
+APP_EVENT_SUBSCRIBE_FINAL(MODULE, sensor_batch_event);
 #if CONFIG_CAF_SENSOR_MANAGER_PM
 APP_EVENT_SUBSCRIBE(MODULE, power_down_event);
 APP_EVENT_SUBSCRIBE(MODULE, wake_up_event);
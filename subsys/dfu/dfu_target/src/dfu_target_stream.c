@@ -16,6 +16,12 @@
 #include <zephyr/settings/settings.h>
 #endif /* CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS */
 
+#ifdef CONFIG_DFU_TARGET_STREAM_HASH
+#include <zephyr/drivers/flash.h>
+#include <mbedtls/sha256.h>
+#define HASH_LEN 32
+#endif /* CONFIG_DFU_TARGET_STREAM_HASH */
+
 LOG_MODULE_REGISTER(dfu_target_stream, CONFIG_DFU_TARGET_LOG_LEVEL);
 
 static struct stream_flash_ctx stream;
@@ -24,16 +30,25 @@ static const char *current_id;
 #ifdef CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS
 
 static char current_name_key[32];
+static size_t stored_bytes_written;
 
 /**
  * @brief Store the information stored in the stream_flash instance so that it
  *        can be restored from flash in case of a power failure, reboot etc.
+ *
+ * The number of bytes written only changes when the stream_flash buffer is
+ * flushed to flash, so the progress is stored only if it differs from the
+ * last stored value.
  */
 static int store_progress(void)
 {
 	int err;
 	size_t bytes_written = stream_flash_bytes_written(&stream);
 
+	if (bytes_written == stored_bytes_written) {
+		return 0;
+	}
+
 	err = settings_save_one(current_name_key, &bytes_written,
 				sizeof(bytes_written));
 
@@ -42,6 +57,8 @@ static int store_progress(void)
 		return err;
 	}
 
+	stored_bytes_written = bytes_written;
+
 	return 0;
 }
 
@@ -65,6 +82,8 @@ static int settings_set(const char *key, size_t len_rd,
 			return len;
 		}
 
+		stored_bytes_written = stream.bytes_written;
+
 		/* Zero bytes written - set last erased page to its default. */
 		if (stream.bytes_written == 0) {
 			stream.last_erased_page_start_offset = -1;
@@ -91,6 +110,86 @@ static int settings_set(const char *key, size_t len_rd,
 }
 #endif /* CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS */
 
+#ifdef CONFIG_DFU_TARGET_STREAM_HASH
+
+static mbedtls_sha256_context hash_ctx;
+static uint8_t hash[HASH_LEN];
+static bool hash_valid;
+
+/**
+ * @brief Start calculating the digest of the stream.
+ *
+ * If the stream is resumed, the data written before the reboot is read back
+ * from flash using the stream buffer, which is unused at this point.
+ */
+static int hash_start(uint8_t *buf, size_t buf_len)
+{
+	int err;
+	size_t bytes_written = stream_flash_bytes_written(&stream);
+
+	hash_valid = false;
+
+	mbedtls_sha256_init(&hash_ctx);
+	err = mbedtls_sha256_starts(&hash_ctx, false);
+	if (err != 0) {
+		LOG_ERR("mbedtls_sha256_starts error %d", err);
+		goto error;
+	}
+
+	for (size_t pos = 0; pos < bytes_written; pos += buf_len) {
+		size_t part_len = MIN(buf_len, bytes_written - pos);
+
+		err = flash_read(stream.fdev, stream.offset + pos, buf,
+				 part_len);
+		if (err != 0) {
+			LOG_ERR("flash_read error %d", err);
+			goto error;
+		}
+
+		err = mbedtls_sha256_update(&hash_ctx, buf, part_len);
+		if (err != 0) {
+			LOG_ERR("mbedtls_sha256_update error %d", err);
+			goto error;
+		}
+	}
+
+	return 0;
+
+error:
+	mbedtls_sha256_free(&hash_ctx);
+	return err;
+}
+
+static int hash_finish(void)
+{
+	int err = mbedtls_sha256_finish(&hash_ctx, hash);
+
+	if (err != 0) {
+		LOG_ERR("mbedtls_sha256_finish error %d", err);
+	}
+
+	hash_valid = (err == 0);
+	mbedtls_sha256_free(&hash_ctx);
+
+	return err;
+}
+
+int dfu_target_stream_hash_get(uint8_t *out, size_t len)
+{
+	if (!hash_valid) {
+		return -EACCES;
+	}
+
+	if (len < HASH_LEN) {
+		return -ENOMEM;
+	}
+
+	memcpy(out, hash, HASH_LEN);
+
+	return 0;
+}
+#endif /* CONFIG_DFU_TARGET_STREAM_HASH */
+
 struct stream_flash_ctx *dfu_target_stream_get_stream(void)
 {
 	return &stream;
@@ -126,6 +225,9 @@ int dfu_target_stream_init(const struct dfu_target_stream_init *init)
 		return -EFAULT;
 	}
 
+	/* Nothing is stored for a new stream, updated by settings_load(). */
+	stored_bytes_written = 0;
+
 	static struct settings_handler sh = {
 		.name = MODULE,
 		.h_set = settings_set,
@@ -151,6 +253,13 @@ int dfu_target_stream_init(const struct dfu_target_stream_init *init)
 	}
 #endif /* CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS */
 
+#ifdef CONFIG_DFU_TARGET_STREAM_HASH
+	err = hash_start(init->buf, init->len);
+	if (err) {
+		return err;
+	}
+#endif /* CONFIG_DFU_TARGET_STREAM_HASH */
+
 	return 0;
 }
 
@@ -170,6 +279,14 @@ int dfu_target_stream_write(const uint8_t *buf, size_t len)
 		return err;
 	}
 
+#ifdef CONFIG_DFU_TARGET_STREAM_HASH
+	err = mbedtls_sha256_update(&hash_ctx, buf, len);
+	if (err != 0) {
+		LOG_ERR("mbedtls_sha256_update error %d", err);
+		return err;
+	}
+#endif
+
 #ifdef CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS
 	err = store_progress();
 	if (err != 0) {
@@ -192,26 +309,45 @@ int dfu_target_stream_done(bool successful)
 		if (err != 0) {
 			LOG_ERR("stream_flash_buffered_write error %d", err);
 		}
+	}
+
+#ifdef CONFIG_DFU_TARGET_STREAM_HASH
+	if (successful && err == 0) {
+		/* Frees the hash context. */
+		err = hash_finish();
+	} else {
+		hash_valid = false;
+		mbedtls_sha256_free(&hash_ctx);
+	}
+#endif
+
 #ifdef CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS
+	int store_err;
+
+	if (successful) {
 		/* Delete state so that a new call to 'init' will
 		 * start with offset 0.
 		 */
-		err = settings_delete(current_name_key);
-		if (err != 0) {
-			LOG_ERR("setting_delete error %d", err);
+		store_err = settings_delete(current_name_key);
+		if (store_err != 0) {
+			LOG_ERR("setting_delete error %d", store_err);
 		}
-
 	} else {
 		/* The stream has not completed, store the progress so that
 		 * a new call to 'init' will pick up where we left off.
 		 */
-		err = store_progress();
-		if (err != 0) {
-			LOG_ERR("Unable to reset write progress: %d", err);
+		store_err = store_progress();
+		if (store_err != 0) {
+			LOG_ERR("Unable to reset write progress: %d", store_err);
 		}
-#endif
 	}
 
+	/* Report the first error. */
+	if (err == 0) {
+		err = store_err;
+	}
+#endif
+
 	current_id = NULL;
 
 	return err;
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef NRF_CLOUD_OUTBOX_H__
+#define NRF_CLOUD_OUTBOX_H__
+
+#include <stdbool.h>
+#include <net/nrf_cloud.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**@brief Initialize the outbox.
+ *
+ * If CONFIG_NRF_CLOUD_OUTBOX_PERSISTENT is enabled, the messages stored in
+ * settings are loaded into the outbox the first time this is called.
+ *
+ * @return 0 if successful, otherwise a negative error code.
+ */
+int nct_outbox_init(void);
+
+/**@brief Copy a message or bulk topic message to the outbox.
+ *
+ * @retval 0 If the message was queued.
+ * @retval -EINVAL If the topic or QoS is not supported.
+ * @retval -ENOMEM If the message is larger than the outbox.
+ */
+int nct_outbox_put(const struct nrf_cloud_tx_data *msg);
+
+/**@brief Send queued messages on the data channel, oldest first.
+ *
+ * Messages are removed from the outbox once they have been published.
+ * Sending stops at the first failure and is retried on the next call.
+ *
+ * @return 0 if the outbox was emptied, otherwise a negative error code.
+ */
+int nct_outbox_flush(void);
+
+/**@brief Check whether messages are waiting in the outbox. */
+bool nct_outbox_pending(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NRF_CLOUD_OUTBOX_H__ */
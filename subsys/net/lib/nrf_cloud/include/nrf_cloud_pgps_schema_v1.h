@@ -31,6 +31,14 @@ extern "C" {
 #define PGPS_SENTINEL_SIZE sizeof(((struct nrf_cloud_pgps_prediction *)0)->sentinel)
 #define PGPS_PREDICTION_DL_SIZE (sizeof(struct nrf_cloud_pgps_prediction) - \
 				 PGPS_SCHEMA_SIZE - PGPS_SENTINEL_SIZE)
+/* CRC32 of the stored prediction, kept at the start of the padding. */
+#define PGPS_CRC_OFFSET sizeof(struct nrf_cloud_pgps_prediction)
+#define PGPS_CRC_SIZE sizeof(uint32_t)
+/* CRC32 of the prediction header and sentinel, following the prediction CRC. */
+#define PGPS_HDR_CRC_OFFSET (PGPS_CRC_OFFSET + PGPS_CRC_SIZE)
+#define PGPS_HDR_SIZE offsetof(struct nrf_cloud_pgps_prediction, ephemerii)
+/* Predictions stored before the CRCs were added have erased padding. */
+#define PGPS_CRC_ERASED 0xFFFFFFFFU
 
 struct nrf_cloud_pgps_header {
 	uint8_t schema_version;
@@ -72,6 +72,8 @@ void npgps_free_block(int block);
 int npgps_get_block_extent(int block);
 void npgps_reset_block_pool(void);
 void npgps_mark_block_used(int block, bool used);
+bool npgps_block_verified(int block);
+void npgps_mark_block_verified(int block);
 void npgps_print_blocks(void);
 int npgps_num_free(void);
 int npgps_find_first_free(int from_block);
@@ -22,6 +22,7 @@ enum nct_evt_type {
 	NCT_EVT_CC_TX_DATA_ACK,
 	NCT_EVT_PINGRESP,
 	NCT_EVT_DC_RX_DATA,
+	NCT_EVT_DC_RX_FRAGMENT,
 	NCT_EVT_DC_TX_DATA_ACK,
 	NCT_EVT_CC_DISCONNECTED,
 	NCT_EVT_DC_DISCONNECTED,
@@ -40,6 +41,11 @@ struct nct_dc_data {
 	struct nrf_cloud_data data;
 	struct nrf_cloud_topic topic;
 	uint16_t message_id;
+	/* Offset of data in the message and total length of the message,
+	 * for NCT_EVT_DC_RX_FRAGMENT
+	 */
+	uint32_t offset;
+	uint32_t total_len;
 };
 
 struct nct_cc_data {
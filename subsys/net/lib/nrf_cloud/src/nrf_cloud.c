@@ -15,6 +15,7 @@
 #include "nrf_cloud_transport.h"
 #include "nrf_cloud_fota.h"
 #include "nrf_cloud_mem.h"
+#include "nrf_cloud_outbox.h"
 
 #include <zephyr/logging/log.h>
 
@@ -130,6 +131,14 @@ int nrf_cloud_init(const struct nrf_cloud_init_param *param)
 		return err;
 	}
 
+#if defined(CONFIG_NRF_CLOUD_OUTBOX)
+	/* Messages stored before a reboot are sent once connected. */
+	err = nct_outbox_init();
+	if (err) {
+		LOG_WRN("Failed to restore the outbox, error: %d", err);
+	}
+#endif
+
 	app_event_handler = param->event_handler;
 
 	nfsm_set_current_state_and_notify(STATE_INITIALIZED, NULL);
@@ -382,6 +391,22 @@ int nrf_cloud_send(const struct nrf_cloud_tx_data *msg)
 		return -EINVAL;
 	}
 
+#if defined(CONFIG_NRF_CLOUD_OUTBOX)
+	/* Queue data channel messages while disconnected, and keep them queued
+	 * behind older messages until the outbox has been sent.
+	 */
+	if (((msg->topic_type == NRF_CLOUD_TOPIC_MESSAGE) ||
+	     (msg->topic_type == NRF_CLOUD_TOPIC_BULK)) &&
+	    ((current_state != STATE_DC_CONNECTED) || nct_outbox_pending())) {
+		err = nct_outbox_put(msg);
+		if (!err && (current_state == STATE_DC_CONNECTED)) {
+			(void)nct_outbox_flush();
+		}
+
+		return err;
+	}
+#endif
+
 	switch (msg->topic_type) {
 	case NRF_CLOUD_TOPIC_STATE: {
 		if (current_state < STATE_CC_CONNECTED) {
@@ -7,6 +7,7 @@
 #include "nrf_cloud_fsm.h"
 #include "nrf_cloud_codec.h"
 #include "nrf_cloud_mem.h"
+#include "nrf_cloud_outbox.h"
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #if defined(CONFIG_NRF_CLOUD_AGPS)
@@ -29,6 +30,7 @@ static int cc_tx_ack_in_state_requested_handler(const struct nct_evt *nct_evt);
 static int cc_disconnection_handler(const struct nct_evt *nct_evt);
 static int dc_connection_handler(const struct nct_evt *nct_evt);
 static int dc_rx_data_handler(const struct nct_evt *nct_evt);
+static int dc_rx_fragment_handler(const struct nct_evt *nct_evt);
 static int dc_tx_ack_handler(const struct nct_evt *nct_evt);
 static int dc_disconnection_handler(const struct nct_evt *nct_evt);
 static int cc_rx_data_handler(const struct nct_evt *nct_evt);
@@ -86,6 +88,7 @@ static const fsm_transition dc_connected_fsm_transition[NCT_EVT_TOTAL] = {
 	[NCT_EVT_CC_TX_DATA_ACK] = cc_tx_ack_handler,
 	[NCT_EVT_PINGRESP] = cc_tx_ack_handler,
 	[NCT_EVT_DC_RX_DATA] = dc_rx_data_handler,
+	[NCT_EVT_DC_RX_FRAGMENT] = dc_rx_fragment_handler,
 	[NCT_EVT_DC_TX_DATA_ACK] = dc_tx_ack_handler,
 	[NCT_EVT_CC_DISCONNECTED] = cc_disconnection_handler,
 	[NCT_EVT_DC_DISCONNECTED] = dc_disconnection_handler,
@@ -527,6 +530,9 @@ static int dc_connection_handler(const struct nct_evt *nct_evt)
 		nfsm_set_current_state_and_notify(nfsm_get_current_state(), &evt);
 	} else {
 		nfsm_set_current_state_and_notify(STATE_DC_CONNECTED, &evt);
+#if defined(CONFIG_NRF_CLOUD_OUTBOX)
+		(void)nct_outbox_flush();
+#endif
 	}
 
 	return 0;
@@ -659,6 +665,24 @@ static int dc_rx_data_handler(const struct nct_evt *nct_evt)
 	return 0;
 }
 
+static int dc_rx_fragment_handler(const struct nct_evt *nct_evt)
+{
+	__ASSERT_NO_MSG(nct_evt != NULL);
+	__ASSERT_NO_MSG(nct_evt->param.dc != NULL);
+
+	struct nrf_cloud_evt cloud_evt = {
+		.type = NRF_CLOUD_EVT_RX_DATA_FRAGMENT,
+		.data = nct_evt->param.dc->data,
+		.topic = nct_evt->param.dc->topic,
+		.fragment.offset = nct_evt->param.dc->offset,
+		.fragment.total_len = nct_evt->param.dc->total_len,
+	};
+
+	nfsm_set_current_state_and_notify(nfsm_get_current_state(), &cloud_evt);
+
+	return 0;
+}
+
 static int dc_tx_ack_handler(const struct nct_evt *nct_evt)
 {
 	return 0; /* Nothing to do */
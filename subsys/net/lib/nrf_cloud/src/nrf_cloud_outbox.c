@@ -0,0 +1,444 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/slist.h>
+#include <zephyr/settings/settings.h>
+#include <net/nrf_cloud.h>
+#include "nrf_cloud_outbox.h"
+#include "nrf_cloud_transport.h"
+
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(nrf_cloud_outbox, CONFIG_NRF_CLOUD_LOG_LEVEL);
+
+#define OUTBOX_SETTINGS_KEY	"outbox"
+#define OUTBOX_SETTINGS_NAME	NRF_CLOUD_SETTINGS_NAME "/" OUTBOX_SETTINGS_KEY
+/* Sequence numbers are stored as 8 hexadecimal digits. */
+#define OUTBOX_KEY_LEN		(sizeof(OUTBOX_SETTINGS_NAME "/") + 8)
+
+/* Part of a message that is stored in settings, followed by the payload. */
+struct outbox_hdr {
+	uint8_t topic_type;
+	uint8_t qos;
+	/* The payload can be part of a bulk topic batch. */
+	uint8_t batchable;
+	uint8_t reserved;
+};
+
+struct outbox_msg {
+	sys_snode_t node;
+	uint32_t seq;
+	size_t len;
+	struct outbox_hdr hdr;
+	uint8_t data[];
+};
+
+BUILD_ASSERT(offsetof(struct outbox_msg, data) ==
+	     offsetof(struct outbox_msg, hdr) + sizeof(struct outbox_hdr),
+	     "Payload must follow the stored header");
+
+K_HEAP_DEFINE(outbox_heap, CONFIG_NRF_CLOUD_OUTBOX_SIZE);
+static K_MUTEX_DEFINE(outbox_lock);
+static sys_slist_t outbox = SYS_SLIST_STATIC_INIT(&outbox);
+static struct nrf_cloud_outbox_stats stats;
+static uint32_t next_seq;
+
+#if defined(CONFIG_NRF_CLOUD_OUTBOX_COALESCE)
+/* Consecutive message topic payloads that are JSON objects are sent to the
+ * bulk topic as a single JSON array.
+ */
+static uint8_t batch_buf[CONFIG_NRF_CLOUD_OUTBOX_BATCH_SIZE];
+#endif
+
+#if defined(CONFIG_NRF_CLOUD_OUTBOX_PERSISTENT)
+/* Other modules load the settings tree that the stored messages are part of, so
+ * stored messages are only accepted while nct_outbox_init() loads them.
+ */
+static bool loading;
+
+static int outbox_settings_set(const char *key, size_t len_rd,
+			       settings_read_cb read_cb, void *cb_arg);
+
+SETTINGS_STATIC_HANDLER_DEFINE(nrf_cloud_outbox, OUTBOX_SETTINGS_NAME, NULL,
+			       outbox_settings_set, NULL, NULL);
+
+static void msg_key_get(uint32_t seq, char *key)
+{
+	(void)snprintf(key, OUTBOX_KEY_LEN, OUTBOX_SETTINGS_NAME "/%08x", (unsigned int)seq);
+}
+
+static void msg_store(const struct outbox_msg *msg)
+{
+	char key[OUTBOX_KEY_LEN];
+	int err;
+
+	msg_key_get(msg->seq, key);
+	err = settings_save_one(key, &msg->hdr, sizeof(msg->hdr) + msg->len);
+	if (err) {
+		LOG_WRN("Failed to store queued message, error: %d", err);
+	}
+}
+
+static void msg_unstore(const struct outbox_msg *msg)
+{
+	char key[OUTBOX_KEY_LEN];
+	int err;
+
+	msg_key_get(msg->seq, key);
+	err = settings_delete(key);
+	if (err) {
+		LOG_WRN("Failed to delete stored message, error: %d", err);
+	}
+}
+
+/* Stored messages can be loaded in any order, so they are inserted by sequence number. */
+static void msg_insert(struct outbox_msg *msg)
+{
+	struct outbox_msg *prev = NULL;
+	struct outbox_msg *iter;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&outbox, iter, node) {
+		if (iter->seq > msg->seq) {
+			break;
+		}
+		prev = iter;
+	}
+
+	if (prev) {
+		sys_slist_insert(&outbox, &prev->node, &msg->node);
+	} else {
+		sys_slist_prepend(&outbox, &msg->node);
+	}
+}
+
+static int outbox_settings_set(const char *key, size_t len_rd,
+			       settings_read_cb read_cb, void *cb_arg)
+{
+	struct outbox_msg *msg;
+	char *end;
+	uint32_t seq;
+	ssize_t sz;
+
+	if (!loading) {
+		return 0;
+	}
+
+	if (!key) {
+		return -EINVAL;
+	}
+
+	seq = strtoul(key, &end, 16);
+	if ((end == key) || (*end != '\0') || (len_rd <= sizeof(struct outbox_hdr))) {
+		LOG_WRN("Invalid stored message: %s", key);
+		return -EINVAL;
+	}
+
+	msg = k_heap_alloc(&outbox_heap, sizeof(*msg) + len_rd - sizeof(struct outbox_hdr),
+			   K_NO_WAIT);
+	if (!msg) {
+		char full_key[OUTBOX_KEY_LEN];
+
+		/* Possible if the outbox size was reduced, the message can never be loaded. */
+		LOG_WRN("Stored message %s does not fit in the outbox, dropping it", key);
+		stats.dropped_msgs++;
+		msg_key_get(seq, full_key);
+		(void)settings_delete(full_key);
+		return -ENOMEM;
+	}
+
+	sz = read_cb(cb_arg, &msg->hdr, len_rd);
+	if (sz != len_rd) {
+		k_heap_free(&outbox_heap, msg);
+		return (sz == 0) ? -EIDRM : -EIO;
+	}
+
+	msg->seq = seq;
+	msg->len = len_rd - sizeof(struct outbox_hdr);
+	msg_insert(msg);
+
+	stats.queued_msgs++;
+	stats.queued_bytes += msg->len;
+	next_seq = MAX(next_seq, seq + 1);
+
+	return 0;
+}
+#endif /* CONFIG_NRF_CLOUD_OUTBOX_PERSISTENT */
+
+int nct_outbox_init(void)
+{
+#if defined(CONFIG_NRF_CLOUD_OUTBOX_PERSISTENT)
+	static bool loaded;
+	int err = 0;
+
+	k_mutex_lock(&outbox_lock, K_FOREVER);
+
+	if (!loaded) {
+		err = settings_subsys_init();
+		if (err) {
+			LOG_ERR("Settings init failed: %d", err);
+			goto unlock;
+		}
+
+		loading = true;
+		err = settings_load_subtree(OUTBOX_SETTINGS_NAME);
+		loading = false;
+		if (err) {
+			LOG_ERR("Cannot load stored messages: %d", err);
+			goto unlock;
+		}
+
+		loaded = true;
+		LOG_DBG("Loaded %u stored messages", stats.queued_msgs);
+	}
+
+unlock:
+	k_mutex_unlock(&outbox_lock);
+
+	return err;
+#else
+	return 0;
+#endif
+}
+
+static void msg_free(struct outbox_msg *msg)
+{
+#if defined(CONFIG_NRF_CLOUD_OUTBOX_PERSISTENT)
+	msg_unstore(msg);
+#endif
+	stats.queued_msgs--;
+	stats.queued_bytes -= msg->len;
+	k_heap_free(&outbox_heap, msg);
+}
+
+/* Only JSON objects can be elements of a batch, the bulk topic expects an array of them. */
+static bool is_json_object(const uint8_t *data, size_t len)
+{
+	while (len && isspace((int)data[len - 1])) {
+		len--;
+	}
+	while (len && isspace((int)data[0])) {
+		data++;
+		len--;
+	}
+
+	return (len >= 2) && (data[0] == '{') && (data[len - 1] == '}');
+}
+
+int nct_outbox_put(const struct nrf_cloud_tx_data *msg)
+{
+	struct outbox_msg *entry;
+
+	if ((msg->topic_type != NRF_CLOUD_TOPIC_MESSAGE) &&
+	    (msg->topic_type != NRF_CLOUD_TOPIC_BULK)) {
+		return -EINVAL;
+	}
+
+	if ((msg->qos != MQTT_QOS_0_AT_MOST_ONCE) &&
+	    (msg->qos != MQTT_QOS_1_AT_LEAST_ONCE)) {
+		return -EINVAL;
+	}
+
+	if (!msg->data.ptr || !msg->data.len) {
+		return -EINVAL;
+	}
+
+	/* Do not flush the whole outbox for a message that can never fit. */
+	if (sizeof(struct outbox_msg) + msg->data.len > CONFIG_NRF_CLOUD_OUTBOX_SIZE) {
+		LOG_ERR("Message of %zu bytes does not fit in the outbox", msg->data.len);
+		return -ENOMEM;
+	}
+
+	k_mutex_lock(&outbox_lock, K_FOREVER);
+
+	/* Make room by dropping the oldest messages. */
+	while (!(entry = k_heap_alloc(&outbox_heap, sizeof(*entry) + msg->data.len,
+				      K_NO_WAIT))) {
+		sys_snode_t *sn = sys_slist_get(&outbox);
+		struct outbox_msg *oldest = SYS_SLIST_CONTAINER(sn, oldest, node);
+
+		if (!oldest) {
+			k_mutex_unlock(&outbox_lock);
+			LOG_ERR("Message of %zu bytes does not fit in the outbox",
+				msg->data.len);
+			return -ENOMEM;
+		}
+
+		stats.dropped_msgs++;
+		LOG_WRN("Outbox full, dropping oldest message");
+		msg_free(oldest);
+	}
+
+	entry->seq = next_seq++;
+	entry->len = msg->data.len;
+	entry->hdr = (struct outbox_hdr) {
+		.topic_type = msg->topic_type,
+		.qos = msg->qos,
+		.batchable = IS_ENABLED(CONFIG_NRF_CLOUD_OUTBOX_COALESCE) &&
+			     (msg->topic_type == NRF_CLOUD_TOPIC_MESSAGE) &&
+			     is_json_object(msg->data.ptr, msg->data.len),
+	};
+	memcpy(entry->data, msg->data.ptr, msg->data.len);
+
+	sys_slist_append(&outbox, &entry->node);
+	stats.queued_msgs++;
+	stats.queued_bytes += entry->len;
+
+#if defined(CONFIG_NRF_CLOUD_OUTBOX_PERSISTENT)
+	msg_store(entry);
+#endif
+
+	k_mutex_unlock(&outbox_lock);
+
+	LOG_DBG("Queued %zu bytes, %u messages pending", msg->data.len, stats.queued_msgs);
+
+	return 0;
+}
+
+bool nct_outbox_pending(void)
+{
+	return !sys_slist_is_empty(&outbox);
+}
+
+#if defined(CONFIG_NRF_CLOUD_OUTBOX_COALESCE)
+/* Build a JSON array of consecutive batchable entries, starting at head.
+ * Returns the number of entries in the batch; 0 or 1 means no batch was built.
+ */
+static size_t batch_build(struct outbox_msg *head, size_t *len, enum mqtt_qos *qos)
+{
+	struct outbox_msg *msg = head;
+	size_t pos = 1;
+	size_t count = 0;
+
+	batch_buf[0] = '[';
+	*qos = MQTT_QOS_0_AT_MOST_ONCE;
+
+	while (msg && msg->hdr.batchable &&
+	       (pos + msg->len + 1 <= sizeof(batch_buf))) {
+		memcpy(&batch_buf[pos], msg->data, msg->len);
+		pos += msg->len;
+		batch_buf[pos++] = ',';
+		*qos = MAX(*qos, msg->hdr.qos);
+		count++;
+
+		msg = SYS_SLIST_PEEK_NEXT_CONTAINER(msg, node);
+	}
+
+	/* Replace the trailing separator. */
+	batch_buf[pos - 1] = ']';
+	*len = pos;
+
+	return count;
+}
+#endif /* CONFIG_NRF_CLOUD_OUTBOX_COALESCE */
+
+/* Send one queued message to the topic it was queued for. */
+static int msg_send(const struct outbox_msg *msg)
+{
+	const struct nct_dc_data buf = {
+		.data.ptr = msg->data,
+		.data.len = msg->len,
+		.message_id = NCT_MSG_ID_USE_NEXT_INCREMENT
+	};
+
+	if (msg->hdr.topic_type == NRF_CLOUD_TOPIC_BULK) {
+		return nct_dc_bulk_send(&buf, msg->hdr.qos);
+	}
+
+	return (msg->hdr.qos == MQTT_QOS_0_AT_MOST_ONCE) ? nct_dc_stream(&buf) :
+							    nct_dc_send(&buf);
+}
+
+/* Send the message at the head of the outbox, coalesced with the following ones if
+ * possible. Returns the number of messages sent, or a negative error code.
+ */
+static int head_send(struct outbox_msg *head, size_t *len)
+{
+	int err;
+
+#if defined(CONFIG_NRF_CLOUD_OUTBOX_COALESCE)
+	enum mqtt_qos qos;
+	size_t count = batch_build(head, len, &qos);
+
+	if (count > 1) {
+		const struct nct_dc_data buf = {
+			.data.ptr = batch_buf,
+			.data.len = *len,
+			.message_id = NCT_MSG_ID_USE_NEXT_INCREMENT
+		};
+
+		err = nct_dc_bulk_send(&buf, qos);
+
+		return err ? err : count;
+	}
+#endif
+
+	*len = head->len;
+	err = msg_send(head);
+
+	return err ? err : 1;
+}
+
+int nct_outbox_flush(void)
+{
+	struct outbox_msg *head;
+	uint32_t sent_msgs = 0;
+	uint32_t sent_bytes = 0;
+	uint32_t publishes = 0;
+	int err = 0;
+
+	k_mutex_lock(&outbox_lock, K_FOREVER);
+
+	while ((head = SYS_SLIST_PEEK_HEAD_CONTAINER(&outbox, head, node))) {
+		size_t len;
+		int count = head_send(head, &len);
+
+		if (count < 0) {
+			err = count;
+			LOG_WRN("Outbox flush stopped, error: %d", err);
+			break;
+		}
+
+		publishes++;
+		sent_msgs += count;
+		sent_bytes += len;
+
+		while (count--) {
+			sys_snode_t *sn = sys_slist_get(&outbox);
+
+			msg_free(SYS_SLIST_CONTAINER(sn, head, node));
+		}
+	}
+
+	if (publishes) {
+		stats.last_flush_msgs = sent_msgs;
+		stats.last_flush_bytes = sent_bytes;
+		stats.last_flush_publishes = publishes;
+		LOG_DBG("Outbox sent %u messages, %u bytes in %u publishes",
+			sent_msgs, sent_bytes, publishes);
+	}
+
+	k_mutex_unlock(&outbox_lock);
+
+	return err;
+}
+
+int nrf_cloud_outbox_stats_get(struct nrf_cloud_outbox_stats *const out)
+{
+	if (!out) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&outbox_lock, K_FOREVER);
+	*out = stats;
+	k_mutex_unlock(&outbox_lock);
+
+	return 0;
+}
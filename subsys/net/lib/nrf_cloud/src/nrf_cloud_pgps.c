@@ -8,6 +8,8 @@
 #include <nrfx_nvmc.h>
 #include <zephyr/device.h>
 #include <zephyr/storage/stream_flash.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
 
 #include <cJSON.h>
 #include <modem/modem_info.h>
@@ -45,6 +47,8 @@ BUILD_ASSERT(((REPLACEMENT_THRESHOLD & 1) == 0),
 	 "REPLACEMENT_THRESHOLD must be even");
 BUILD_ASSERT((NUM_PREDICTIONS != REPLACEMENT_THRESHOLD),
 	 "NUM_PREDICTIONS and REPLACEMENT_THRESHOLD cannot be equal");
+BUILD_ASSERT((PGPS_PREDICTION_PAD >= PGPS_CRC_SIZE),
+	 "No room for the prediction CRC");
 
 enum pgps_state {
 	PGPS_NONE,
@@ -70,6 +74,7 @@ struct pgps_index {
 	uint8_t pnum_offset;
 	uint8_t cur_pnum;
 	bool partial_request;
+	bool resume_needed;
 	bool stale_server_data;
 	uint32_t storage_extent;
 	int store_block;
@@ -91,6 +96,7 @@ static uint32_t flash_page_size;
 static uint8_t prediction_buf[PGPS_PREDICTION_STORAGE_SIZE];
 static atomic_t accept_packets;
 static atomic_t pgps_need_assistance;
+static struct nrf_cloud_pgps_stats stats;
 
 static int validate_stored_predictions(uint16_t *bad_day, uint32_t *bad_time);
 static void log_pgps_header(const char *msg, const struct nrf_cloud_pgps_header *header);
@@ -104,6 +110,9 @@ static void print_time_details(const char *info,
 			       int64_t sec, uint16_t day, uint32_t time_of_day);
 static int pgps_request(const struct gps_pgps_request *request);
 static int pgps_request_all(void);
+static int pgps_request_missing(uint16_t num_valid);
+static int pgps_request_resume(void);
+static int flush_storage(void);
 
 K_WORK_DEFINE(prediction_work, prediction_work_handler);
 K_TIMER_DEFINE(prediction_timer, prediction_timer_handler, NULL);
@@ -228,6 +237,54 @@ static int validate_prediction(const struct nrf_cloud_pgps_prediction *p,
 	return err;
 }
 
+static int verify_prediction_crc(const struct nrf_cloud_pgps_prediction *p)
+{
+	int block = npgps_pointer_to_block((uint8_t *)p);
+	uint32_t stored_crc;
+	uint32_t crc;
+
+	__ASSERT(block != -1, "unexpected pointer value %p", p);
+	if (npgps_block_verified(block)) {
+		return 0;
+	}
+
+	stored_crc = sys_get_le32((const uint8_t *)p + PGPS_CRC_OFFSET);
+	if (stored_crc == PGPS_CRC_ERASED) {
+		LOG_DBG("prediction at:%p has no crc; stored by older version", p);
+	} else {
+		crc = crc32_ieee((const uint8_t *)p, sizeof(*p));
+		if (crc != stored_crc) {
+			LOG_ERR("prediction at:%p has crc:0x%08X, expected:0x%08X",
+				p, stored_crc, crc);
+			return -EINVAL;
+		}
+	}
+
+	npgps_mark_block_verified(block);
+	return 0;
+}
+
+static int verify_prediction_hdr_crc(const struct nrf_cloud_pgps_prediction *p)
+{
+	uint32_t stored_crc;
+	uint32_t crc;
+
+	stored_crc = sys_get_le32((const uint8_t *)p + PGPS_HDR_CRC_OFFSET);
+	if (stored_crc == PGPS_CRC_ERASED) {
+		return 0;
+	}
+
+	crc = crc32_ieee((const uint8_t *)p, PGPS_HDR_SIZE);
+	crc = crc32_ieee_update(crc, (const uint8_t *)&p->sentinel, sizeof(p->sentinel));
+	if (crc != stored_crc) {
+		LOG_ERR("prediction at:%p has header crc:0x%08X, expected:0x%08X",
+			p, stored_crc, crc);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
 static int validate_stored_predictions(uint16_t *first_bad_day,
 				       uint32_t *first_bad_time)
 {
@@ -268,7 +325,10 @@ static int validate_stored_predictions(uint16_t *first_bad_day,
 		p += PGPS_PREDICTION_STORAGE_SIZE;
 	}
 
-	/* validate predictions in time order, independent of storage order */
+	/* validate predictions in time order, independent of storage order;
+	 * only the prediction headers and their CRCs are checked here, the CRC
+	 * of each whole prediction is checked when it is first used
+	 */
 	i = -1;
 	for (pnum = 0; pnum < count; pnum++) {
 		/* calculate expected time signature */
@@ -286,6 +346,9 @@ static int validate_stored_predictions(uint16_t *first_bad_day,
 
 		err = validate_prediction(pred, gps_day, gps_time_of_day,
 					  period_min, true, false);
+		if (!err) {
+			err = verify_prediction_hdr_crc(pred);
+		}
 		if (err) {
 			LOG_ERR("Prediction num:%u, gps_day:%u, "
 				"gps_time_of_day:%u is bad:%d; loc:%p",
@@ -414,7 +477,7 @@ int nrf_cloud_pgps_notify_prediction(void)
 	} else if (err < 0) {
 		if (!pgps_need_assistance) {
 			pgps_need_assistance = true;
-			err = pgps_request_all();
+			err = pgps_request_resume();
 			if (err) {
 				LOG_ERR("Error while requesting pgps set: %d", err);
 				pgps_need_assistance = false; /* try again next time */
@@ -583,6 +646,11 @@ int nrf_cloud_pgps_find_prediction(struct nrf_cloud_pgps_prediction **prediction
 	index.cur_pnum = pnum;
 	*prediction = index.predictions[pnum];
 	if (*prediction) {
+		err = verify_prediction_crc(*prediction);
+		if (err) {
+			*prediction = NULL;
+			return err;
+		}
 		err = validate_prediction(*prediction,
 					  cur_gps_day, cur_gps_time_of_day,
 					  period_min, false, margin);
@@ -656,10 +724,14 @@ static int pgps_request(const struct gps_pgps_request *request)
 		index.partial_request = true;
 		index.pnum_offset = index.header.prediction_count -
 				    request->prediction_count;
+		stats.partial_requests++;
+		stats.bytes_saved += index.pnum_offset * PGPS_PREDICTION_DL_SIZE;
 	} else {
 		index.partial_request = false;
 		index.pnum_offset = 0;
+		stats.full_requests++;
 	}
+	index.resume_needed = false;
 
 	index.expected_count = request->prediction_count;
 	accept_packets = true;
@@ -786,6 +858,78 @@ static int pgps_request_all(void)
 	return pgps_request(&request);
 }
 
+static int pgps_request_missing(uint16_t num_valid)
+{
+	struct gps_pgps_request request;
+	uint16_t gps_day;
+	uint32_t gps_time_of_day;
+
+	__ASSERT_NO_MSG(num_valid < index.header.prediction_count);
+
+	get_prediction_day_time(num_valid, NULL, &gps_day, &gps_time_of_day);
+
+	request.gps_day = gps_day;
+	request.gps_time_of_day = gps_time_of_day;
+	request.prediction_count = index.header.prediction_count - num_valid;
+	request.prediction_period_min = index.header.prediction_period_min;
+
+	return pgps_request(&request);
+}
+
+/* continue an interrupted download from the first prediction not stored,
+ * or request the full set if nothing could be kept
+ */
+static int pgps_request_resume(void)
+{
+	uint16_t num_valid;
+	uint16_t gps_day;
+	uint32_t gps_time_of_day;
+
+	if (!index.resume_needed || nrf_cloud_pgps_loading()) {
+		return pgps_request_all();
+	}
+
+	num_valid = validate_stored_predictions(&gps_day, &gps_time_of_day);
+	if ((num_valid == 0) || (num_valid >= index.header.prediction_count)) {
+		index.resume_needed = false;
+		return (num_valid == 0) ? pgps_request_all() : 0;
+	}
+
+	LOG_INF("Resuming P-GPS download at prediction num:%u", num_valid);
+	stats.resumed_requests++;
+	return pgps_request_missing(num_valid);
+}
+
+/* keep what was stored by a download that ended before all
+ * requested predictions were received
+ */
+static void pgps_download_interrupted(void)
+{
+	uint16_t num_valid;
+	uint16_t gps_day;
+	uint32_t gps_time_of_day;
+	int err;
+
+	err = flush_storage();
+	if (err) {
+		LOG_ERR("Error flushing storage:%d", err);
+	}
+
+	/* rebuild the block pool from what actually reached flash */
+	num_valid = validate_stored_predictions(&gps_day, &gps_time_of_day);
+	LOG_WRN("P-GPS download interrupted; %u of %u predictions stored",
+		num_valid, index.header.prediction_count);
+
+	if (num_valid == 0) {
+		index.resume_needed = false;
+		index.cur_pnum = 0xff;
+		state = PGPS_EXPIRED;
+	} else {
+		index.resume_needed = true;
+		state = PGPS_READY;
+	}
+}
+
 #if defined(CONFIG_NRF_CLOUD_PGPS_DOWNLOAD_TRANSPORT_HTTP)
 /* handle incoming P-GPS response packets */
 int nrf_cloud_pgps_process(const char *buf, size_t buf_len)
@@ -863,8 +1007,8 @@ int nrf_cloud_pgps_preemptive_updates(void)
 		return 0;
 	}
 
-	if (current == 0xff) {
-		return pgps_request_all();
+	if ((current == 0xff) || index.resume_needed) {
+		return pgps_request_resume();
 	}
 
 	if ((current + npgps_num_free()) < n) {
@@ -1108,16 +1252,32 @@ static int open_storage(uint32_t offset, bool preserve)
 static int store_prediction(uint8_t *p, size_t len, uint32_t sentinel, bool last)
 {
 	static bool first = true;
-	static uint8_t pad[PGPS_PREDICTION_PAD];
+	static uint8_t pad[PGPS_PREDICTION_PAD - 2 * PGPS_CRC_SIZE];
 	int err;
 	uint8_t schema = NRF_CLOUD_AGPS_BIN_SCHEMA_VERSION;
 	size_t schema_offset = ((size_t) &((struct nrf_cloud_pgps_prediction *)0)->schema_version);
+	uint8_t crc_buf[2 * PGPS_CRC_SIZE];
+	uint32_t crc;
+	uint32_t hdr_crc;
 
 	if (first) {
-		memset(pad, 0xff, PGPS_PREDICTION_PAD);
+		memset(pad, 0xff, sizeof(pad));
 		first = false;
 	}
 
+	/* compute the CRCs of the prediction and of its header as they will
+	 * be laid out in flash; the header CRC is checked at boot
+	 */
+	crc = crc32_ieee(p, schema_offset);
+	crc = crc32_ieee_update(crc, &schema, sizeof(schema));
+	hdr_crc = crc32_ieee_update(crc, p + schema_offset,
+				    PGPS_HDR_SIZE - schema_offset - sizeof(schema));
+	hdr_crc = crc32_ieee_update(hdr_crc, (uint8_t *)&sentinel, sizeof(sentinel));
+	crc = crc32_ieee_update(crc, p + schema_offset, len - schema_offset);
+	crc = crc32_ieee_update(crc, (uint8_t *)&sentinel, sizeof(sentinel));
+	sys_put_le32(crc, crc_buf);
+	sys_put_le32(hdr_crc, crc_buf + PGPS_CRC_SIZE);
+
 	err = stream_flash_buffered_write(&stream, p, schema_offset, false);
 	if (err) {
 		LOG_ERR("Error writing pgps prediction:%d", err);
@@ -1140,7 +1300,11 @@ static int store_prediction(uint8_t *p, size_t len, uint32_t sentinel, bool last
 	if (err) {
 		LOG_ERR("Error writing sentinel:%d", err);
 	}
-	err = stream_flash_buffered_write(&stream, pad, PGPS_PREDICTION_PAD, last);
+	err = stream_flash_buffered_write(&stream, crc_buf, sizeof(crc_buf), false);
+	if (err) {
+		LOG_ERR("Error writing crc:%d", err);
+	}
+	err = stream_flash_buffered_write(&stream, pad, sizeof(pad), last);
 	if (err) {
 		LOG_ERR("Error writing sentinel:%d", err);
 	}
@@ -1162,6 +1326,8 @@ int nrf_cloud_pgps_process_update(uint8_t *buf, size_t len)
 		return -EINVAL;
 	}
 
+	stats.bytes_downloaded += len;
+
 	if (index.dl_offset == 0) {
 		struct nrf_cloud_pgps_header *header;
 
@@ -1508,6 +1674,9 @@ int nrf_cloud_pgps_begin_update(void)
 int nrf_cloud_pgps_finish_update(void)
 {
 	if (IS_ENABLED(CONFIG_NRF_CLOUD_PGPS_DOWNLOAD_TRANSPORT_CUSTOM)) {
+		if (state == PGPS_LOADING) {
+			pgps_download_interrupted();
+		}
 		npgps_unlock();
 		return 0;
 	}
@@ -1524,11 +1693,24 @@ static void end_transfer_handler(int transfer_result)
 		} else {
 			LOG_ERR("Download failed: %d", transfer_result);
 		}
-		nrf_cloud_pgps_finish_update();
+		if (state == PGPS_LOADING) {
+			pgps_download_interrupted();
+		}
+		npgps_unlock();
 	}
 }
 #endif /* CONFIG_NRF_CLOUD_PGPS_DOWNLOAD_TRANSPORT_HTTP */
 
+int nrf_cloud_pgps_stats_get(struct nrf_cloud_pgps_stats *const out)
+{
+	if (!out) {
+		return -EINVAL;
+	}
+
+	*out = stats;
+	return 0;
+}
+
 int nrf_cloud_pgps_init(struct nrf_cloud_pgps_init_param *param)
 {
 	int err = 0;
@@ -1668,19 +1850,10 @@ int nrf_cloud_pgps_init(struct nrf_cloud_pgps_init_param *param)
 			return 0;
 		}
 		/* read missing predictions at end */
-		struct gps_pgps_request request;
-
 		LOG_INF("Incomplete P-GPS data; "
 			"Creating request for %u predictions...", count - num_valid);
 
-		get_prediction_day_time(num_valid, NULL, &gps_day, &gps_time_of_day);
-
-		request.gps_day = gps_day;
-		request.gps_time_of_day = gps_time_of_day;
-		request.prediction_count = count - num_valid;
-		request.prediction_period_min = period_min;
-
-		err = pgps_request(&request);
+		err = pgps_request_missing(num_valid);
 	} else if ((count - (pnum + 1)) < REPLACEMENT_THRESHOLD) {
 		if (!IS_ENABLED(CONFIG_NRF_CLOUD_PGPS_REQUEST_UPON_INIT)) {
 			return 0;
@@ -33,6 +33,7 @@ struct block_pool {
 	int first_free;
 	uint32_t last_alloc;
 	bool block_used[NUM_PREDICTIONS];
+	bool block_verified[NUM_PREDICTIONS];
 };
 
 static struct block_pool pool;
@@ -310,6 +311,7 @@ int npgps_alloc_block(void)
 
 	idx = pool.first_free;
 	pool.block_used[pool.first_free] = true;
+	pool.block_verified[pool.first_free] = false;
 	pool.first_free = (pool.first_free + 1) % num_blocks;
 	if (pool.block_used[pool.first_free]) {
 		pool.first_free = NO_BLOCK;
@@ -325,6 +327,7 @@ void npgps_free_block(int block)
 		pool.first_free = block;
 	}
 	pool.block_used[block] = false;
+	pool.block_verified[block] = false;
 }
 
 int npgps_get_block_extent(int block)
@@ -350,6 +353,7 @@ void npgps_reset_block_pool(void)
 	pool.first_free = 0;
 	for (i = 0; i < num_blocks; i++) {
 		pool.block_used[i] = false;
+		pool.block_verified[i] = false;
 	}
 }
 
@@ -360,6 +364,18 @@ void npgps_mark_block_used(int block, bool used)
 	LOG_DBG("mark idx:%d = %u", block, used);
 }
 
+bool npgps_block_verified(int block)
+{
+	__ASSERT((block >= 0) && (block < num_blocks), "block %d out of range", block);
+	return pool.block_verified[block];
+}
+
+void npgps_mark_block_verified(int block)
+{
+	__ASSERT((block >= 0) && (block < num_blocks), "block %d out of range", block);
+	pool.block_verified[block] = true;
+}
+
 void npgps_print_blocks(void)
 {
 	char map[num_blocks + 1];
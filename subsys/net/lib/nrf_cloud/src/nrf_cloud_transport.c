@@ -844,6 +844,48 @@ static int publish_get_payload(struct mqtt_client *client, size_t length)
 	return ret;
 }
 
+/* Reads a data channel message that does not fit the payload buffer in buffer sized
+ * fragments, and passes each one on as soon as it is read.
+ */
+static int publish_fragments_input(struct mqtt_client *client,
+				   const struct mqtt_publish_param *p)
+{
+	int err;
+	size_t frag_len;
+	struct nct_dc_data dc = {
+		.message_id = p->message_id,
+		.topic.len = p->message.topic.topic.size,
+		.topic.ptr = p->message.topic.topic.utf8,
+		.total_len = p->message.payload.len,
+	};
+	struct nct_evt evt = {
+		.type = NCT_EVT_DC_RX_FRAGMENT,
+		.param.dc = &dc,
+	};
+
+	while (dc.offset < dc.total_len) {
+		frag_len = MIN(dc.total_len - dc.offset, sizeof(nct.payload_buf) - 1);
+
+		err = mqtt_readall_publish_payload(client, nct.payload_buf, frag_len);
+		if (err) {
+			return err;
+		}
+		nct.payload_buf[frag_len] = 0;
+
+		dc.data.ptr = nct.payload_buf;
+		dc.data.len = frag_len;
+
+		err = nct_input(&evt);
+		if (err) {
+			LOG_ERR("nct_input: failed %d", err);
+		}
+
+		dc.offset += frag_len;
+	}
+
+	return 0;
+}
+
 static int translate_mqtt_connack_result(const int mqtt_result)
 {
 	switch (mqtt_result) {
@@ -925,8 +967,17 @@ static void nct_mqtt_evt_handler(struct mqtt_client *const mqtt_client,
 			p->message.topic.topic.size,
 			p->message.topic.topic.utf8);
 
-		int err = publish_get_payload(mqtt_client,
-					      p->message.payload.len);
+		bool cc_match = control_channel_topic_match(NCT_RX_LIST, &p->message.topic,
+							    &cc.opcode);
+		bool fragmented = IS_ENABLED(CONFIG_NRF_CLOUD_MQTT_RX_FRAGMENTS) && !cc_match &&
+				  (p->message.payload.len > (sizeof(nct.payload_buf) - 1));
+		int err;
+
+		if (fragmented) {
+			err = publish_fragments_input(mqtt_client, p);
+		} else {
+			err = publish_get_payload(mqtt_client, p->message.payload.len);
+		}
 
 		if (err < 0) {
 			LOG_ERR("publish_get_payload: failed %d", err);
@@ -935,11 +986,12 @@ static void nct_mqtt_evt_handler(struct mqtt_client *const mqtt_client,
 			break;
 		}
 
-		/* If the data arrives on one of the subscribed control channel
-		 * topic. Then we notify the same.
-		 */
-		if (control_channel_topic_match(NCT_RX_LIST, &p->message.topic,
-						&cc.opcode)) {
+		if (fragmented) {
+			/* The fragments have been passed on already */
+		} else if (cc_match) {
+			/* If the data arrives on one of the subscribed control channel
+			 * topic. Then we notify the same.
+			 */
 			cc.message_id = p->message_id;
 			cc.data.ptr = nct.payload_buf;
 			cc.data.len = p->message.payload.len;
@@ -14,6 +14,7 @@
 #include <zephyr/posix/arpa/inet.h>
 #include <zephyr/posix/unistd.h>
 #include <zephyr/posix/netdb.h>
+#include <zephyr/posix/poll.h>
 #include <zephyr/posix/sys/socket.h>
 #else
 #include <zephyr/net/socket.h>
@@ -30,6 +31,144 @@ LOG_MODULE_REGISTER(rest_client, CONFIG_REST_CLIENT_LOG_LEVEL);
 
 #define HTTP_PROTOCOL "HTTP/1.1"
 
+#if defined(CONFIG_REST_CLIENT_CONN_POOL)
+/* Connections to longer host names are not pooled */
+#define POOL_HOST_LEN 64
+
+/* Idle connections kept open for reuse */
+static struct rest_client_pool_entry {
+	int fd;
+	char host[POOL_HOST_LEN];
+	uint16_t port;
+	int sec_tag;
+	int tls_peer_verify;
+	int64_t last_used;
+} pool[CONFIG_REST_CLIENT_CONN_POOL_SIZE] = {
+	[0 ... (CONFIG_REST_CLIENT_CONN_POOL_SIZE - 1)] = { .fd = REST_CLIENT_SCKT_CONNECT }
+};
+
+static K_MUTEX_DEFINE(pool_lock);
+
+static void rest_client_pool_entry_close(struct rest_client_pool_entry *entry)
+{
+	LOG_DBG("Closing pooled socket %d", entry->fd);
+	(void)close(entry->fd);
+	entry->fd = REST_CLIENT_SCKT_CONNECT;
+}
+
+static bool rest_client_pool_entry_match(const struct rest_client_pool_entry *entry,
+					 const struct rest_client_req_context *req_ctx)
+{
+	return entry->port == req_ctx->port &&
+	       entry->sec_tag == req_ctx->sec_tag &&
+	       entry->tls_peer_verify == req_ctx->tls_peer_verify &&
+	       strcmp(entry->host, req_ctx->host) == 0;
+}
+
+static bool rest_client_pool_entry_alive(const struct rest_client_pool_entry *entry)
+{
+	struct pollfd fds = {
+		.fd = entry->fd,
+		.events = POLLIN,
+	};
+
+	/* An idle connection has nothing to read, unless the server has closed it */
+	return poll(&fds, 1, 0) == 0;
+}
+
+/* Returns a pooled connection matching the request, or REST_CLIENT_SCKT_CONNECT */
+static int rest_client_pool_take(const struct rest_client_req_context *req_ctx)
+{
+	int fd = REST_CLIENT_SCKT_CONNECT;
+	int64_t now = k_uptime_get();
+
+	k_mutex_lock(&pool_lock, K_FOREVER);
+	for (size_t i = 0; i < ARRAY_SIZE(pool); i++) {
+		struct rest_client_pool_entry *entry = &pool[i];
+
+		if (entry->fd < 0) {
+			continue;
+		}
+		if (now - entry->last_used >= CONFIG_REST_CLIENT_CONN_POOL_IDLE_TIMEOUT *
+					      MSEC_PER_SEC) {
+			rest_client_pool_entry_close(entry);
+			continue;
+		}
+		if (fd >= 0 || !rest_client_pool_entry_match(entry, req_ctx)) {
+			continue;
+		}
+		if (!rest_client_pool_entry_alive(entry)) {
+			rest_client_pool_entry_close(entry);
+			continue;
+		}
+		fd = entry->fd;
+		entry->fd = REST_CLIENT_SCKT_CONNECT;
+	}
+	k_mutex_unlock(&pool_lock);
+
+	return fd;
+}
+
+static void rest_client_pool_put(const struct rest_client_req_context *req_ctx, int fd)
+{
+	struct rest_client_pool_entry *entry = NULL;
+
+	if (strlen(req_ctx->host) >= POOL_HOST_LEN) {
+		(void)close(fd);
+		return;
+	}
+
+	k_mutex_lock(&pool_lock, K_FOREVER);
+	for (size_t i = 0; i < ARRAY_SIZE(pool); i++) {
+		if (pool[i].fd < 0) {
+			entry = &pool[i];
+			break;
+		}
+		if (entry == NULL || pool[i].last_used < entry->last_used) {
+			entry = &pool[i];
+		}
+	}
+	if (entry->fd >= 0) {
+		/* Pool is full, replace the least recently used connection */
+		rest_client_pool_entry_close(entry);
+	}
+	entry->fd = fd;
+	strcpy(entry->host, req_ctx->host);
+	entry->port = req_ctx->port;
+	entry->sec_tag = req_ctx->sec_tag;
+	entry->tls_peer_verify = req_ctx->tls_peer_verify;
+	entry->last_used = k_uptime_get();
+	k_mutex_unlock(&pool_lock);
+
+	LOG_DBG("Socket %d kept in connection pool", fd);
+}
+
+void rest_client_pool_clear(void)
+{
+	k_mutex_lock(&pool_lock, K_FOREVER);
+	for (size_t i = 0; i < ARRAY_SIZE(pool); i++) {
+		if (pool[i].fd >= 0) {
+			rest_client_pool_entry_close(&pool[i]);
+		}
+	}
+	k_mutex_unlock(&pool_lock);
+}
+#else
+static int rest_client_pool_take(const struct rest_client_req_context *req_ctx)
+{
+	return REST_CLIENT_SCKT_CONNECT;
+}
+
+static void rest_client_pool_put(const struct rest_client_req_context *req_ctx, int fd)
+{
+	(void)close(fd);
+}
+
+void rest_client_pool_clear(void)
+{
+}
+#endif /* CONFIG_REST_CLIENT_CONN_POOL */
+
 static void rest_client_http_response_cb(struct http_response *rsp,
 					  enum http_final_call final_data,
 					  void *user_data)
@@ -262,6 +401,13 @@ static void rest_client_init_request(struct rest_client_req_context *const req_c
 
 	req->response = rest_client_http_response_cb;
 	req->method = req_ctx->http_method;
+	req->url = req_ctx->url;
+	req->header_fields = req_ctx->header_fields;
+
+	if (req_ctx->body != NULL) {
+		req->payload = req_ctx->body;
+		req->payload_len = strlen(req->payload);
+	}
 }
 
 static int rest_client_do_api_call(struct http_request *http_req,
@@ -271,6 +417,10 @@ static int rest_client_do_api_call(struct http_request *http_req,
 	int err = 0;
 	int64_t sckt_connect_start_time;
 	int64_t sckt_connect_time;
+	int64_t transfer_start_time;
+
+	resp_ctx->connect_time_ms = 0;
+	resp_ctx->transfer_time_ms = 0;
 
 	sckt_connect_start_time = k_uptime_get();
 
@@ -301,10 +451,12 @@ static int rest_client_do_api_call(struct http_request *http_req,
 	resp_ctx->used_socket_id = req_ctx->connect_socket;
 	resp_ctx->http_status_code_str[0] = '\0';
 
-	if (req_ctx->timeout_ms != SYS_FOREVER_MS) {
-		/* Take time used for socket connect into account */
-		sckt_connect_time = k_uptime_get() - sckt_connect_start_time;
+	transfer_start_time = k_uptime_get();
+	sckt_connect_time = transfer_start_time - sckt_connect_start_time;
+	resp_ctx->connect_time_ms = sckt_connect_time;
 
+	/* Take time used for socket connect into account */
+	if (req_ctx->timeout_ms != SYS_FOREVER_MS) {
 		/* Check if timeout has already elapsed */
 		if (sckt_connect_time >= req_ctx->timeout_ms) {
 			LOG_WRN("Timeout occurred during socket connect");
@@ -314,6 +466,7 @@ static int rest_client_do_api_call(struct http_request *http_req,
 	}
 
 	err = http_client_req(req_ctx->connect_socket, http_req, req_ctx->timeout_ms, resp_ctx);
+	resp_ctx->transfer_time_ms = k_uptime_get() - transfer_start_time;
 	if (err < 0) {
 		LOG_ERR("http_client_req() error: %d", err);
 	} else if (resp_ctx->total_response_len >= req_ctx->resp_buff_len) {
@@ -328,6 +481,19 @@ static int rest_client_do_api_call(struct http_request *http_req,
 	return err;
 }
 
+/* A pooled connection that the server has already closed fails when the request is
+ * sent, or reaches the end of the stream before any response byte is received.
+ */
+static bool rest_client_pooled_conn_closed(int err,
+					   const struct rest_client_resp_context *resp_ctx)
+{
+	if (resp_ctx->total_response_len > 0) {
+		return false;
+	}
+
+	return err == 0 || err == -ECONNRESET || err == -EPIPE || err == -ENOTCONN;
+}
+
 void rest_client_request_defaults_set(struct rest_client_req_context *req_ctx)
 {
 	__ASSERT_NO_MSG(req_ctx != NULL);
@@ -354,23 +520,50 @@ int rest_client_request(struct rest_client_req_context *req_ctx,
 
 	struct http_request http_req;
 	int ret;
+	bool pooled = false;
+	int32_t timeout_ms = req_ctx->timeout_ms;
+	int64_t start_time;
+
+	if (IS_ENABLED(CONFIG_REST_CLIENT_CONN_POOL) &&
+	    req_ctx->connect_socket == REST_CLIENT_SCKT_CONNECT && !req_ctx->keep_alive) {
+		pooled = true;
+		req_ctx->connect_socket = rest_client_pool_take(req_ctx);
+	}
+	resp_ctx->connection_reused = (pooled && req_ctx->connect_socket >= 0);
 
 	rest_client_init_request(req_ctx, &http_req);
 
-	http_req.url = req_ctx->url;
-
 	LOG_DBG("Requesting destination HOST: %s at port %d, URL: %s",
 		req_ctx->host, req_ctx->port, http_req.url);
 
-	http_req.header_fields = req_ctx->header_fields;
-
-	if (req_ctx->body != NULL) {
-		http_req.payload = req_ctx->body;
-		http_req.payload_len = strlen(http_req.payload);
+	if (http_req.payload != NULL) {
 		LOG_DBG("Payload: %s", http_req.payload);
 	}
 
+	start_time = k_uptime_get();
 	ret = rest_client_do_api_call(&http_req, req_ctx, resp_ctx);
+	if (resp_ctx->connection_reused && rest_client_pooled_conn_closed(ret, resp_ctx)) {
+		/* The server has closed the pooled connection, retry with a new one */
+		LOG_DBG("Pooled socket %d was closed, reconnecting", req_ctx->connect_socket);
+		(void)close(req_ctx->connect_socket);
+		req_ctx->connect_socket = REST_CLIENT_SCKT_CONNECT;
+		resp_ctx->connection_reused = false;
+
+		/* The retry gets what is left of the original timeout */
+		if (timeout_ms != SYS_FOREVER_MS) {
+			int64_t elapsed = k_uptime_get() - start_time;
+
+			if (elapsed >= timeout_ms) {
+				LOG_WRN("Timeout occurred before reconnecting");
+				ret = -ETIMEDOUT;
+				goto clean_up;
+			}
+			req_ctx->timeout_ms = timeout_ms - elapsed;
+		}
+
+		rest_client_init_request(req_ctx, &http_req);
+		ret = rest_client_do_api_call(&http_req, req_ctx, resp_ctx);
+	}
 	if (ret) {
 		LOG_ERR("rest_client_do_api_call() failed, err %d", ret);
 		goto clean_up;
@@ -388,6 +581,11 @@ int rest_client_request(struct rest_client_req_context *req_ctx,
 	LOG_DBG("API call response len: http status: %d, %u bytes", resp_ctx->http_status_code,
 		resp_ctx->response_len);
 
+	if (pooled && http_should_keep_alive(&http_req.internal.parser)) {
+		rest_client_pool_put(req_ctx, req_ctx->connect_socket);
+		req_ctx->connect_socket = REST_CLIENT_SCKT_CONNECT;
+	}
+
 clean_up:
 	if (req_ctx->connect_socket != REST_CLIENT_SCKT_CONNECT) {
 		/* Socket was not closed yet: */
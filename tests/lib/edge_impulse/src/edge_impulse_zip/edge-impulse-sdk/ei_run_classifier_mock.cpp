@@ -7,6 +7,8 @@
 #include <zephyr/ztest.h>
 #include <ei_run_classifier.h>
 
+uint32_t ei_mock_data_read_time;
+static uint32_t data_read_cycles;
 
 /* Input data must be ascending sequence of floats. Difference between
  * subsequent elements of input sequence equals 1. The first element
@@ -26,8 +28,11 @@ static void verify_data_read(signal_t *signal, const size_t prediction_idx,
 	memset(data_buf, 0, sizeof(data_buf));
 
 	for (size_t off = 0; off < data_size; off += chunk_size) {
+		uint32_t start = k_cycle_get_32();
 		int err = signal->get_data(off, chunk_size, data_ptr + off);
 
+		data_read_cycles += k_cycle_get_32() - start;
+
 		zassert_ok(err, "get_data returned an error");
 	}
 
@@ -48,12 +53,15 @@ EI_IMPULSE_ERROR run_classifier(signal_t *signal,
 	ARG_UNUSED(debug);
 
 	/* Test getting data. */
+	data_read_cycles = 0;
 	verify_data_read(signal, prediction_idx, 1);
 	verify_data_read(signal, prediction_idx,
 			 EI_CLASSIFIER_RAW_SAMPLES_PER_FRAME);
 	verify_data_read(signal, prediction_idx,
 			 EI_CLASSIFIER_DSP_INPUT_FRAME_SIZE);
 
+	ei_mock_data_read_time = k_cyc_to_us_ceil32(data_read_cycles);
+
 	/* Busy wait for predefined amount of time to simulate calculations. */
 	k_busy_wait(EI_MOCK_BUSY_WAIT_TIME);
 
@@ -44,4 +44,9 @@ static const char * const ei_classifier_inferencing_categories[] = {
 /* Data processing is simulated as busy wait. */
 #define EI_MOCK_BUSY_WAIT_TIME				(100U)
 
+/* Time spent in input data reads of the last prediction, measured by the
+ * mocked library around each read, rounded up [us].
+ */
+extern uint32_t ei_mock_data_read_time;
+
 #endif /* _EI_TEST_PARAMS_H_ */
@@ -62,6 +62,7 @@ static void verify_result(const size_t pred_idx)
 	int dsp_time;
 	int classification_time;
 	int anomaly_time;
+	uint32_t data_copy_time;
 
 	for (size_t i = 0; i < ei_wrapper_get_classifier_label_count(); i++) {
 		err = ei_wrapper_get_next_classification_result(&label, &value, &idx);
@@ -103,6 +104,15 @@ static void verify_result(const size_t pred_idx)
 	zassert_equal(classification_time, EI_MOCK_GEN_CLASSIFICATION_TIME(pred_idx),
 		      "Wrong classification time");
 	zassert_equal(anomaly_time, EI_MOCK_GEN_ANOMALY_TIME(pred_idx), "Wrong anomaly time");
+
+	err = ei_wrapper_get_data_copy_time(&data_copy_time);
+	zassert_ok(err, "ei_wrapper_get_data_copy_time returned an error");
+	/* Copy time is measured inside the reads done by the mocked library,
+	 * so it must not exceed the time the library spent on reading data.
+	 */
+	zassert_true(data_copy_time <= ei_mock_data_read_time,
+		     "Data copy time %u exceeds data read time %u",
+		     data_copy_time, ei_mock_data_read_time);
 }
 
 static void run_basic_setup(const size_t pred_idx,
@@ -206,6 +216,7 @@ static void test_result_read_fail(void)
 	int dsp_time;
 	int classification_time;
 	int anomaly_time;
+	uint32_t data_copy_time;
 
 	/* Results cannot be read outside of ei_wrapper callback context. */
 	err = ei_wrapper_get_next_classification_result(&label, &value, NULL);
@@ -214,6 +225,8 @@ static void test_result_read_fail(void)
 	zassert_true(err, "No error for ei_wrapper_get_anomaly");
 	err = ei_wrapper_get_timing(&dsp_time, &classification_time, &anomaly_time);
 	zassert_true(err, "No error for ei_wrapper_get_timing");
+	err = ei_wrapper_get_data_copy_time(&data_copy_time);
+	zassert_true(err, "No error for ei_wrapper_get_data_copy_time");
 }
 
 static void test_data_add_fail(void)
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <modem/location.h>
+#include <modem/lte_lc.h>
+
+#include "location_cache.h"
+
+LOG_MODULE_REGISTER(location, CONFIG_LOCATION_LOG_LEVEL);
+
+static struct lte_lc_ncell neighbor_cells[4] = {
+	{ .earfcn = 6400, .phys_cell_id = 10 },
+	{ .earfcn = 6400, .phys_cell_id = 11 },
+	{ .earfcn = 6400, .phys_cell_id = 12 },
+	{ .earfcn = 300, .phys_cell_id = 13 },
+};
+
+static struct lte_lc_cells_info cells = {
+	.current_cell = {
+		.mcc = 244,
+		.mnc = 91,
+		.tac = 0x1234,
+		.id = 0x00112233,
+	},
+	.ncells_count = ARRAY_SIZE(neighbor_cells),
+	.neighbor_cells = neighbor_cells,
+};
+
+static const struct location_data position = {
+	.latitude = 61.49,
+	.longitude = 23.77,
+	.accuracy = 300.0f,
+};
+
+static const uint8_t macs[][6] = {
+	{ 0x00, 0x11, 0x22, 0x33, 0x44, 0x55 },
+	{ 0x00, 0x11, 0x22, 0x33, 0x44, 0x56 },
+	{ 0x66, 0x11, 0x22, 0x33, 0x44, 0x57 },
+};
+
+static void setup(void)
+{
+	zassert_equal(location_cache_clear(), 0, "Clear failed");
+}
+
+static void test_cellular(void)
+{
+	struct location_cache_key key;
+	struct location_data location = { 0 };
+	struct location_cache_stats stats;
+
+	setup();
+
+	location_cache_key_from_cells(&key, &cells);
+	zassert_false(location_cache_lookup(&key, &location), "Hit in empty cache");
+
+	location_cache_store(&key, &position);
+	zassert_true(location_cache_lookup(&key, &location), "Stored position not found");
+	zassert_equal(location.latitude, position.latitude, "Wrong latitude");
+	zassert_equal(location.longitude, position.longitude, "Wrong longitude");
+	zassert_equal(location.accuracy, position.accuracy, "Wrong accuracy");
+
+	/* Three of four neighbors still visible */
+	cells.ncells_count = 3;
+	location_cache_key_from_cells(&key, &cells);
+	zassert_true(location_cache_lookup(&key, &location), "Similar cells not matched");
+
+	/* Only one of four neighbors visible */
+	cells.ncells_count = 1;
+	location_cache_key_from_cells(&key, &cells);
+	zassert_false(location_cache_lookup(&key, &location), "Different cells matched");
+	cells.ncells_count = ARRAY_SIZE(neighbor_cells);
+
+	/* Serving cell changed */
+	cells.current_cell.id++;
+	location_cache_key_from_cells(&key, &cells);
+	zassert_false(location_cache_lookup(&key, &location), "Other serving cell matched");
+	cells.current_cell.id--;
+
+	zassert_equal(location_cache_stats_get(&stats), 0, "Stats failed");
+	zassert_equal(stats.hits, 2, "Wrong hit count %d", stats.hits);
+	zassert_equal(stats.misses, 3, "Wrong miss count %d", stats.misses);
+}
+
+static void test_wifi(void)
+{
+	struct location_cache_key key = { .method = LOCATION_METHOD_WIFI };
+	struct location_cache_key other = { .method = LOCATION_METHOD_WIFI };
+	struct location_data location;
+
+	setup();
+
+	for (int i = 0; i < ARRAY_SIZE(macs); i++) {
+		location_cache_key_wifi_add(&key, macs[i]);
+	}
+
+	location_cache_store(&key, &position);
+
+	/* Same access points in a different order */
+	for (int i = ARRAY_SIZE(macs) - 1; i >= 0; i--) {
+		location_cache_key_wifi_add(&other, macs[i]);
+	}
+	zassert_true(location_cache_lookup(&other, &location), "Reordered APs not matched");
+
+	/* One of three access points is not enough */
+	other.id_cnt = 0;
+	location_cache_key_wifi_add(&other, macs[0]);
+	zassert_false(location_cache_lookup(&other, &location), "Different APs matched");
+
+	/* Wi-Fi and cellular positions are never mixed */
+	other = key;
+	other.method = LOCATION_METHOD_CELLULAR;
+	zassert_false(location_cache_lookup(&other, &location), "Wrong method matched");
+}
+
+static void test_lru(void)
+{
+	struct location_cache_key keys[CONFIG_LOCATION_CACHE_SIZE + 1];
+	struct location_data location;
+
+	setup();
+
+	for (int i = 0; i < ARRAY_SIZE(keys); i++) {
+		cells.current_cell.id = i;
+		location_cache_key_from_cells(&keys[i], &cells);
+	}
+
+	location_cache_store(&keys[0], &position);
+	k_sleep(K_MSEC(10));
+	location_cache_store(&keys[1], &position);
+	k_sleep(K_MSEC(10));
+
+	/* Use the oldest entry so that the second one is replaced */
+	zassert_true(location_cache_lookup(&keys[0], &location), "First entry missing");
+	k_sleep(K_MSEC(10));
+	location_cache_store(&keys[2], &position);
+
+	zassert_true(location_cache_lookup(&keys[0], &location), "Recently used replaced");
+	zassert_false(location_cache_lookup(&keys[1], &location), "LRU entry not replaced");
+	zassert_true(location_cache_lookup(&keys[2], &location), "New entry missing");
+}
+
+static void test_ttl(void)
+{
+	struct location_cache_key key;
+	struct location_data location;
+
+	setup();
+
+	location_cache_key_from_cells(&key, &cells);
+	location_cache_store(&key, &position);
+	zassert_true(location_cache_lookup(&key, &location), "Stored position not found");
+
+	k_sleep(K_SECONDS(CONFIG_LOCATION_CACHE_TTL));
+	zassert_false(location_cache_lookup(&key, &location), "Expired position used");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(location_cache_test,
+			 ztest_unit_test(test_cellular),
+			 ztest_unit_test(test_wifi),
+			 ztest_unit_test(test_lru),
+			 ztest_unit_test(test_ttl)
+			 );
+
+	ztest_run_test_suite(location_cache_test);
+}
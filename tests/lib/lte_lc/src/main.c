@@ -312,7 +312,7 @@ static void test_parse_ncellmeas(void)
 	};
 
 	/* Valid response with two neighbors and timing advance measurement time. */
-	err = parse_ncellmeas(resp1, &cells);
+	err = parse_ncellmeas(resp1, &cells, ARRAY_SIZE(ncells));
 	zassert_equal(err, 0, "parse_ncellmeas failed, error: %d", err);
 	zassert_equal(cells.current_cell.mcc, 242, "Wrong MCC");
 	zassert_equal(cells.current_cell.mnc, 1, "Wrong MNC");
@@ -336,10 +336,19 @@ static void test_parse_ncellmeas(void)
 	zassert_equal(cells.neighbor_cells[1].rsrq, 27, "Wrong RSRQ");
 	zassert_equal(cells.neighbor_cells[1].time_diff, 24, "Wrong time difference");
 
+	/* More neighbors than fit in the buffer. */
+	err = parse_ncellmeas(resp1, &cells, 1);
+	zassert_equal(err, -E2BIG, "parse_ncellmeas was expected to return -E2BIG, but returned %d",
+		      err);
+	zassert_equal(cells.ncells_count, 1, "Wrong neighbor cell count");
+	zassert_equal(cells.neighbor_cells[0].phys_cell_id, 194, "Wrong physical cell ID");
+	zassert_equal(cells.current_cell.timing_advance_meas_time, 8061152878017748,
+		      "Wrong timing advance measurement time");
+
 	memset(&cells, 0, sizeof(cells));
 
 	/* Valid response of failed measurement. */
-	err = parse_ncellmeas(resp2, &cells);
+	err = parse_ncellmeas(resp2, &cells, 0);
 	zassert_equal(err, 1, "parse_ncellmeas was expected to return 1, but returned %d", err);
 	zassert_equal(cells.current_cell.id, LTE_LC_CELL_EUTRAN_ID_INVALID, "Wrong cell ID");
 	zassert_equal(cells.ncells_count, 0, "Wrong neighbor cell count");
@@ -347,7 +356,7 @@ static void test_parse_ncellmeas(void)
 	memset(&cells, 0, sizeof(cells));
 
 	/* Valid response with timing advance measurement time. */
-	err = parse_ncellmeas(resp3, &cells);
+	err = parse_ncellmeas(resp3, &cells, 0);
 	zassert_equal(err, 0, "parse_ncellmeas was expected to return 0, but returned %d", err);
 	zassert_equal(cells.current_cell.mcc, 242, "Wrong MCC");
 	zassert_equal(cells.current_cell.mnc, 1, "Wrong MNC");
@@ -364,7 +373,7 @@ static void test_parse_ncellmeas(void)
 	memset(&cells, 0, sizeof(cells));
 
 	/* Valid response without timing advance measurement time. */
-	err = parse_ncellmeas(resp4, &cells);
+	err = parse_ncellmeas(resp4, &cells, 0);
 	zassert_equal(err, 0, "parse_ncellmeas was expected to return 0, but returned %d", err);
 	zassert_equal(cells.current_cell.mcc, 242, "Wrong MCC");
 	zassert_equal(cells.current_cell.mnc, 2, "Wrong MNC");
@@ -379,21 +388,285 @@ static void test_parse_ncellmeas(void)
 	zassert_equal(cells.ncells_count, 0, "Wrong neighbor cell count");
 }
 
-static void test_neighborcell_count_get(void)
+static void test_parse_ncellmeas_malformed(void)
+{
+	int err;
+	/* Recorded response with a line ending, and the same response truncated
+	 * at different positions.
+	 */
+	const char *recorded = "%NCELLMEAS: 0,\"021D140C\",\"24201\",\"0821\",65535,5300,"
+			       "449,50,15,10891,5300,194,46,8,0,1650,292,60,27,24,"
+			       "8061152878017748\r\n";
+	const char *invalid[] = {
+		"%NCELLMEAS: ",
+		"%NCELLMEAS: 0,\"021D140C\",\"24201\",\"0821",
+		"%NCELLMEAS: 0,\"021D140C\",\"24201\",\"0821\",65535,5300,449,50,15",
+		"%NCELLMEAS: 0,\"021D140C\",\"24201\",\"0821\",65535,5300,449,50,15,10891,"
+		"5300,194,46",
+		"%NCELLMEAS: 0,\"021D140C\",\"2\",\"0821\",65535,5300,449,50,15,10891",
+		"%NCELLMEAS: 0,\"021D140C\",\"24201\",\"0821\",abc,5300,449,50,15,10891",
+		"%NCELLMEAS: 0,\"021D140C\",\"24201\",\"0821\",65535,5300,449,50,15,10891,"
+		"5300,194,46,8,99999999999",
+	};
+	struct lte_lc_ncell ncells[2];
+	struct lte_lc_cells_info cells = {
+		.neighbor_cells = ncells,
+	};
+
+	err = parse_ncellmeas(recorded, &cells, ARRAY_SIZE(ncells));
+	zassert_equal(err, 0, "parse_ncellmeas failed, error: %d", err);
+	zassert_equal(cells.current_cell.id, 35460108, "Wrong cell ID");
+	zassert_equal(cells.ncells_count, 2, "Wrong neighbor cell count");
+	zassert_equal(cells.neighbor_cells[1].time_diff, 24, "Wrong time difference");
+	zassert_equal(cells.current_cell.timing_advance_meas_time, 8061152878017748,
+		      "Wrong timing advance measurement time");
+
+	for (int i = 0; i < ARRAY_SIZE(invalid); i++) {
+		err = parse_ncellmeas(invalid[i], &cells, ARRAY_SIZE(ncells));
+		zassert_true(err < 0, "Malformed response %d accepted", i);
+		zassert_true(cells.ncells_count <= ARRAY_SIZE(ncells),
+			     "Neighbor cells overflowed");
+	}
+
+	/* Other notifications are ignored. */
+	err = parse_ncellmeas("+CEREG: 5", &cells, ARRAY_SIZE(ncells));
+	zassert_equal(err, 0, "parse_ncellmeas failed, error: %d", err);
+	zassert_equal(cells.current_cell.id, LTE_LC_CELL_EUTRAN_ID_INVALID, "Wrong cell ID");
+}
+
+static void test_parse_ncellmeas_gci(void)
+{
+	int err;
+	const char *resp =
+		"%NCELLMEAS: 0,"
+		"\"00011B07\",\"26295\",\"00B7\",10,24202,6400,465,63,15,24202,1,2,"
+		"6400,1,50,10,0,6400,2,40,5,-10,"
+		"\"00011B08\",\"26295\",\"00B7\",65535,0,6400,466,55,10,24202,0,0,"
+		"\"00011B09\",\"26296\",\"00B8\",65535,0,300,467,50,8,24203,0,0";
+	struct lte_lc_ncellmeas_params params = {
+		.search_type = LTE_LC_NEIGHBOR_SEARCH_TYPE_GCI_DEFAULT,
+		.gci_count = 5,
+	};
+	struct lte_lc_cell gci_cells[5];
+	struct lte_lc_ncell ncells[CONFIG_LTE_NEIGHBOR_CELLS_MAX];
+	struct lte_lc_cells_info cells = {
+		.gci_cells = gci_cells,
+		.neighbor_cells = ncells,
+	};
+
+	err = parse_ncellmeas_gci(&params, resp, &cells);
+	zassert_equal(err, 0, "parse_ncellmeas_gci failed, error: %d", err);
+
+	zassert_equal(cells.current_cell.id, 0x00011B07, "Wrong cell ID");
+	zassert_equal(cells.current_cell.mcc, 262, "Wrong MCC");
+	zassert_equal(cells.current_cell.mnc, 95, "Wrong MNC");
+	zassert_equal(cells.current_cell.tac, 0xB7, "Wrong TAC");
+	zassert_equal(cells.current_cell.timing_advance, 10, "Wrong timing advance");
+	zassert_equal(cells.current_cell.timing_advance_meas_time, 24202,
+		      "Wrong timing advance measurement time");
+	zassert_equal(cells.current_cell.earfcn, 6400, "Wrong EARFCN");
+	zassert_equal(cells.current_cell.phys_cell_id, 465, "Wrong physical cell ID");
+	zassert_equal(cells.current_cell.measurement_time, 24202, "Wrong measurement time");
+
+	zassert_equal(cells.ncells_count, 2, "Wrong neighbor cell count");
+	zassert_equal(cells.neighbor_cells[0].phys_cell_id, 1, "Wrong physical cell ID");
+	zassert_equal(cells.neighbor_cells[1].phys_cell_id, 2, "Wrong physical cell ID");
+	zassert_equal(cells.neighbor_cells[1].time_diff, -10, "Wrong time difference");
+
+	zassert_equal(cells.gci_cells_count, 2, "Wrong GCI cell count");
+	zassert_equal(cells.gci_cells[0].id, 0x00011B08, "Wrong GCI cell ID");
+	zassert_equal(cells.gci_cells[0].timing_advance, 65535, "Wrong timing advance");
+	zassert_equal(cells.gci_cells[1].id, 0x00011B09, "Wrong GCI cell ID");
+	zassert_equal(cells.gci_cells[1].mnc, 96, "Wrong MNC");
+	zassert_equal(cells.gci_cells[1].earfcn, 300, "Wrong EARFCN");
+
+	/* Only the first GCI cells up to gci_count are parsed. */
+	params.gci_count = 2;
+	err = parse_ncellmeas_gci(&params, resp, &cells);
+	zassert_equal(err, 0, "parse_ncellmeas_gci failed, error: %d", err);
+	zassert_equal(cells.gci_cells_count, 1, "Wrong GCI cell count");
+
+	/* Failed measurement. */
+	err = parse_ncellmeas_gci(&params, "%NCELLMEAS: 1", &cells);
+	zassert_equal(err, 1, "parse_ncellmeas_gci was expected to return 1, but returned %d",
+		      err);
+	zassert_equal(cells.current_cell.id, LTE_LC_CELL_EUTRAN_ID_INVALID, "Wrong cell ID");
+}
+
+static void cell_assert_equal(const struct lte_lc_cell *cell,
+			      const struct lte_lc_cell *expected, int i)
+{
+	zassert_equal(cell->id, expected->id, "Wrong cell ID in response %d", i);
+	zassert_equal(cell->mcc, expected->mcc, "Wrong MCC in response %d", i);
+	zassert_equal(cell->mnc, expected->mnc, "Wrong MNC in response %d", i);
+	zassert_equal(cell->tac, expected->tac, "Wrong TAC in response %d", i);
+	zassert_equal(cell->timing_advance, expected->timing_advance,
+		      "Wrong timing advance in response %d", i);
+	zassert_equal(cell->timing_advance_meas_time, expected->timing_advance_meas_time,
+		      "Wrong timing advance measurement time in response %d", i);
+	zassert_equal(cell->earfcn, expected->earfcn, "Wrong EARFCN in response %d", i);
+	zassert_equal(cell->phys_cell_id, expected->phys_cell_id,
+		      "Wrong physical cell ID in response %d", i);
+	zassert_equal(cell->rsrp, expected->rsrp, "Wrong RSRP in response %d", i);
+	zassert_equal(cell->rsrq, expected->rsrq, "Wrong RSRQ in response %d", i);
+	zassert_equal(cell->measurement_time, expected->measurement_time,
+		      "Wrong measurement time in response %d", i);
+}
+
+static void ncell_assert_equal(const struct lte_lc_ncell *ncell,
+			       const struct lte_lc_ncell *expected, int i)
 {
-	char *resp1 = "%NCELLMEAS: 1,2,3,4,5,6,7,8,9,10,1,2,3,4,5,1,2,3,4,5,1,2,3,4,5,1,2,3,4,5,"
-		      "1,2,3,4,5,1,2,3,4,5,1,2,3,4,5,1,2,3,4,5,1,2,3,4,5,1,2,3,4,5,1,2,3,4,5,"
-		      "1,2,3,4,5,1,2,3,4,5,1,2,3,4,5,1,2,3,4,5,1,2,3,4,5,1,2,3,4,5,1000";
-	char *resp2 = "%NCELLMEAS: 1,2,3,4,5,6,7,8,9,10,1,2,3,4,5,1,2,3,4,5,1,2,3,4,5,1,2,3,1000";
-	char *resp3 = "%NCELLMEAS: 1,2,3,4,5,6,7,8,9,10,1000";
-	char *resp4 = "%NCELLMEAS: ";
-	char *resp5 = " ";
-
-	zassert_equal(17, neighborcell_count_get(resp1), "Wrong neighbor cell count");
-	zassert_equal(3, neighborcell_count_get(resp2), "Wrong neighbor cell count");
-	zassert_equal(0, neighborcell_count_get(resp3), "Wrong neighbor cell count");
-	zassert_equal(0, neighborcell_count_get(resp4), "Wrong neighbor cell count");
-	zassert_equal(0, neighborcell_count_get(resp5), "Wrong neighbor cell count");
+	zassert_equal(ncell->earfcn, expected->earfcn, "Wrong EARFCN in response %d", i);
+	zassert_equal(ncell->phys_cell_id, expected->phys_cell_id,
+		      "Wrong physical cell ID in response %d", i);
+	zassert_equal(ncell->rsrp, expected->rsrp, "Wrong RSRP in response %d", i);
+	zassert_equal(ncell->rsrq, expected->rsrq, "Wrong RSRQ in response %d", i);
+	zassert_equal(ncell->time_diff, expected->time_diff,
+		      "Wrong time difference in response %d", i);
+}
+
+/* The expected values are the output of the at_params based parser that
+ * parse_ncellmeas() and parse_ncellmeas_gci() replaced, for the same responses.
+ */
+static void test_parse_ncellmeas_reference(void)
+{
+	int err;
+	static const struct lte_lc_cell serving_1 = {
+		.id = 35460108, .mcc = 242, .mnc = 1, .tac = 2081, .timing_advance = 65535,
+		.timing_advance_meas_time = 8061152878017748, .earfcn = 5300,
+		.phys_cell_id = 449, .rsrp = 50, .rsrq = 15, .measurement_time = 10891,
+	};
+	static const struct lte_lc_ncell ncells_1[] = {
+		{ .earfcn = 5300, .phys_cell_id = 194, .rsrp = 46, .rsrq = 8, .time_diff = 0 },
+		{ .earfcn = 1650, .phys_cell_id = 292, .rsrp = 60, .rsrq = 27, .time_diff = 24 },
+	};
+	const struct {
+		const char *resp;
+		int err;
+		struct lte_lc_cell current_cell;
+		const struct lte_lc_ncell *ncells;
+		size_t ncells_count;
+	} reference[] = {
+		{
+			.resp = "%NCELLMEAS: 0,\"021D140C\",\"24201\",\"0821\",65535,5300,"
+				"449,50,15,10891,5300,194,46,8,0,1650,292,60,27,24,"
+				"8061152878017748",
+			.current_cell = serving_1,
+			.ncells = ncells_1,
+			.ncells_count = ARRAY_SIZE(ncells_1),
+		},
+		{
+			.resp = "%NCELLMEAS: 0,\"021D140C\",\"24201\",\"0821\",65535,5300,"
+				"449,50,15,10891,5300,194,46,8,0,1650,292,60,27,24,"
+				"8061152878017748\r\n",
+			.current_cell = serving_1,
+			.ncells = ncells_1,
+			.ncells_count = ARRAY_SIZE(ncells_1),
+		},
+		{
+			.resp = "%NCELLMEAS: 1,\"021D140C\",\"24201\",\"0821\",65535,5300,50000",
+			.err = 1,
+			.current_cell = { .id = LTE_LC_CELL_EUTRAN_ID_INVALID },
+		},
+		{
+			.resp = "%NCELLMEAS: 0,\"071D340C\",\"24201\",\"0821\",65535,5300,"
+				"449,50,15,10891,655350",
+			.current_cell = {
+				.id = 119354380, .mcc = 242, .mnc = 1, .tac = 2081,
+				.timing_advance = 65535, .timing_advance_meas_time = 655350,
+				.earfcn = 5300, .phys_cell_id = 449, .rsrp = 50, .rsrq = 15,
+				.measurement_time = 10891,
+			},
+		},
+		{
+			.resp = "%NCELLMEAS: 0,\"071D340C\",\"24202\",\"0762\",65535,5300,"
+				"449,50,15,10871",
+			.current_cell = {
+				.id = 119354380, .mcc = 242, .mnc = 2, .tac = 1890,
+				.timing_advance = 65535, .earfcn = 5300, .phys_cell_id = 449,
+				.rsrp = 50, .rsrq = 15, .measurement_time = 10871,
+			},
+		},
+	};
+	static const struct lte_lc_ncell gci_ncells[] = {
+		{ .earfcn = 6400, .phys_cell_id = 1, .rsrp = 50, .rsrq = 10, .time_diff = 0 },
+		{ .earfcn = 6400, .phys_cell_id = 2, .rsrp = 40, .rsrq = 5, .time_diff = -10 },
+	};
+	static const struct lte_lc_cell gci_expected[] = {
+		{
+			.id = 0x00011B07, .mcc = 262, .mnc = 95, .tac = 0xB7, .timing_advance = 10,
+			.timing_advance_meas_time = 24202, .earfcn = 6400, .phys_cell_id = 465,
+			.rsrp = 63, .rsrq = 15, .measurement_time = 24202,
+		},
+		{
+			.id = 0x00011B08, .mcc = 262, .mnc = 95, .tac = 0xB7,
+			.timing_advance = 65535, .earfcn = 6400, .phys_cell_id = 466,
+			.rsrp = 55, .rsrq = 10, .measurement_time = 24202,
+		},
+		{
+			.id = 0x00011B09, .mcc = 262, .mnc = 96, .tac = 0xB8,
+			.timing_advance = 65535, .earfcn = 300, .phys_cell_id = 467,
+			.rsrp = 50, .rsrq = 8, .measurement_time = 24203,
+		},
+	};
+	const char *gci_resp =
+		"%NCELLMEAS: 0,"
+		"\"00011B07\",\"26295\",\"00B7\",10,24202,6400,465,63,15,24202,1,2,"
+		"6400,1,50,10,0,6400,2,40,5,-10,"
+		"\"00011B08\",\"26295\",\"00B7\",65535,0,6400,466,55,10,24202,0,0,"
+		"\"00011B09\",\"26296\",\"00B8\",65535,0,300,467,50,8,24203,0,0";
+	struct lte_lc_ncellmeas_params params = {
+		.search_type = LTE_LC_NEIGHBOR_SEARCH_TYPE_GCI_DEFAULT,
+		.gci_count = 5,
+	};
+	struct lte_lc_cell gci_cells[5];
+	struct lte_lc_ncell ncells[CONFIG_LTE_NEIGHBOR_CELLS_MAX];
+	struct lte_lc_cells_info cells;
+
+	for (int i = 0; i < ARRAY_SIZE(reference); i++) {
+		memset(&cells, 0, sizeof(cells));
+		cells.neighbor_cells = ncells;
+
+		err = parse_ncellmeas(reference[i].resp, &cells, ARRAY_SIZE(ncells));
+		zassert_equal(err, reference[i].err, "Wrong return value %d for response %d",
+			      err, i);
+		cell_assert_equal(&cells.current_cell, &reference[i].current_cell, i);
+		zassert_equal(cells.ncells_count, reference[i].ncells_count,
+			      "Wrong neighbor cell count in response %d", i);
+
+		for (int j = 0; j < cells.ncells_count; j++) {
+			ncell_assert_equal(&cells.neighbor_cells[j], &reference[i].ncells[j], i);
+		}
+
+		/* Without a neighbor cell buffer, only the neighbor cells are skipped. */
+		memset(&cells, 0, sizeof(cells));
+
+		err = parse_ncellmeas(reference[i].resp, &cells, 0);
+		zassert_equal(err, reference[i].err, "Wrong return value %d for response %d",
+			      err, i);
+		cell_assert_equal(&cells.current_cell, &reference[i].current_cell, i);
+		zassert_equal(cells.ncells_count, 0, "Wrong neighbor cell count in response %d", i);
+	}
+
+	memset(&cells, 0, sizeof(cells));
+	cells.gci_cells = gci_cells;
+	cells.neighbor_cells = ncells;
+
+	err = parse_ncellmeas_gci(&params, gci_resp, &cells);
+	zassert_equal(err, 0, "parse_ncellmeas_gci failed, error: %d", err);
+	cell_assert_equal(&cells.current_cell, &gci_expected[0], 0);
+	zassert_equal(cells.ncells_count, ARRAY_SIZE(gci_ncells), "Wrong neighbor cell count");
+
+	for (int j = 0; j < cells.ncells_count; j++) {
+		ncell_assert_equal(&cells.neighbor_cells[j], &gci_ncells[j], j);
+	}
+
+	zassert_equal(cells.gci_cells_count, ARRAY_SIZE(gci_expected) - 1,
+		      "Wrong GCI cell count");
+
+	for (int j = 0; j < cells.gci_cells_count; j++) {
+		cell_assert_equal(&cells.gci_cells[j], &gci_expected[j + 1], j);
+	}
 }
 
 static void test_parse_psm(void)
@@ -811,7 +1084,9 @@ void test_main(void)
 		ztest_unit_test(test_parse_rrc_mode),
 		ztest_unit_test(test_response_is_valid),
 		ztest_unit_test(test_parse_ncellmeas),
-		ztest_unit_test(test_neighborcell_count_get),
+		ztest_unit_test(test_parse_ncellmeas_malformed),
+		ztest_unit_test(test_parse_ncellmeas_gci),
+		ztest_unit_test(test_parse_ncellmeas_reference),
 		ztest_unit_test(test_parse_mdmev),
 		ztest_unit_test(test_parse_psm),
 		ztest_unit_test(test_periodic_search_pattern_get),
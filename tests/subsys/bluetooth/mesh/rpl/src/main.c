@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdint.h>
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/mesh.h>
+#include <mesh/net.h>
+#include <mesh/rpl.h>
+
+#define BENCHMARK_ROUNDS 16
+
+static struct bt_mesh_net_rx rx_at(uint16_t src, uint32_t seq, bool old_iv)
+{
+	return (struct bt_mesh_net_rx) {
+		.ctx.addr = src,
+		.seq = seq,
+		.old_iv = old_iv,
+		.net_if = BT_MESH_NET_IF_ADV,
+		.local_match = 1,
+	};
+}
+
+static bool rpl_check(uint16_t src, uint32_t seq, bool old_iv)
+{
+	struct bt_mesh_net_rx rx = rx_at(src, seq, old_iv);
+
+	return bt_mesh_rpl_check(&rx, NULL);
+}
+
+static void setup(void)
+{
+	bt_mesh_rpl_clear();
+}
+
+static void test_replay(void)
+{
+	setup();
+
+	zassert_false(rpl_check(0x0001, 10, false), "New source rejected");
+	zassert_true(rpl_check(0x0001, 10, false), "Replay accepted");
+	zassert_true(rpl_check(0x0001, 9, false), "Old sequence number accepted");
+	zassert_false(rpl_check(0x0001, 11, false), "Newer sequence number rejected");
+
+	zassert_false(rpl_check(0x0002, 1, false), "Second source rejected");
+	zassert_true(rpl_check(0x0002, 1, false), "Replay of second source accepted");
+	zassert_true(rpl_check(0x0001, 11, false), "First source entry overwritten");
+}
+
+static void test_local(void)
+{
+	struct bt_mesh_net_rx rx = rx_at(0x0001, 10, false);
+
+	setup();
+
+	rx.net_if = BT_MESH_NET_IF_LOCAL;
+	zassert_false(bt_mesh_rpl_check(&rx, NULL), "Local message rejected");
+	zassert_false(bt_mesh_rpl_check(&rx, NULL), "Local message stored in RPL");
+
+	rx = rx_at(0x0001, 10, false);
+	rx.local_match = 0;
+	zassert_false(bt_mesh_rpl_check(&rx, NULL), "Relayed message rejected");
+	zassert_false(bt_mesh_rpl_check(&rx, NULL), "Relayed message stored in RPL");
+}
+
+static void test_match(void)
+{
+	struct bt_mesh_net_rx rx = rx_at(0x0010, 5, false);
+	struct bt_mesh_rpl *match = NULL;
+
+	setup();
+
+	zassert_false(bt_mesh_rpl_check(&rx, &match), "New source rejected");
+	zassert_not_null(match, "No RPL slot returned");
+	zassert_false(bt_mesh_rpl_check(&rx, NULL), "RPL updated without match");
+
+	bt_mesh_rpl_update(match, &rx);
+	zassert_true(rpl_check(0x0010, 5, false), "Replay accepted after update");
+	zassert_false(rpl_check(0x0011, 5, false), "Other source rejected");
+	zassert_true(rpl_check(0x0010, 5, false), "Index lost after insertion");
+}
+
+static void test_iv_update(void)
+{
+	setup();
+
+	zassert_false(rpl_check(0x0001, 100, false), "New source rejected");
+	zassert_false(rpl_check(0x0002, 100, false), "New source rejected");
+	zassert_true(rpl_check(0x0001, 101, true), "Old IV index accepted");
+
+	bt_mesh_rpl_reset();
+
+	/* Entries are flagged as old after the first reset. */
+	zassert_false(rpl_check(0x0001, 1, false), "New IV index rejected");
+	zassert_true(rpl_check(0x0001, 1, false), "Replay accepted after reset");
+
+	bt_mesh_rpl_reset();
+
+	/* Old entry of 0x0002 is discarded and the list is compacted. */
+	zassert_false(rpl_check(0x0002, 1, false), "Discarded source rejected");
+	zassert_true(rpl_check(0x0001, 1, true), "Compacted entry lost");
+	zassert_true(rpl_check(0x0002, 1, false), "New entry lost after compaction");
+}
+
+static void test_full(void)
+{
+	setup();
+
+	for (uint16_t src = 1; src <= CONFIG_BT_MESH_CRPL; src++) {
+		zassert_false(rpl_check(src, 1, false), "Source %u rejected", src);
+	}
+
+	zassert_true(rpl_check(CONFIG_BT_MESH_CRPL + 1, 1, false), "Full RPL accepted source");
+
+	for (uint16_t src = 1; src <= CONFIG_BT_MESH_CRPL; src++) {
+		zassert_true(rpl_check(src, 1, false), "Source %u replay accepted", src);
+		zassert_false(rpl_check(src, 2, false), "Source %u rejected", src);
+	}
+}
+
+static void test_benchmark(void)
+{
+	static const uint16_t fill[] = { 1, 16, 64, 128, CONFIG_BT_MESH_CRPL };
+	uint32_t seq = 1;
+
+	for (size_t i = 0; i < ARRAY_SIZE(fill); i++) {
+		uint32_t start;
+		uint32_t cycles;
+
+		setup();
+
+		for (uint16_t src = 1; src <= fill[i]; src++) {
+			zassert_false(rpl_check(src, seq, false), "Source %u rejected", src);
+		}
+
+		start = k_cycle_get_32();
+
+		for (int round = 0; round < BENCHMARK_ROUNDS; round++) {
+			seq++;
+			for (uint16_t src = 1; src <= fill[i]; src++) {
+				(void)rpl_check(src, seq, false);
+			}
+		}
+
+		cycles = k_cycle_get_32() - start;
+
+		printk("RPL entries: %u, cycles per check: %u\n", fill[i],
+		       cycles / (BENCHMARK_ROUNDS * fill[i]));
+	}
+}
+
+void test_main(void)
+{
+	ztest_test_suite(bt_mesh_rpl_test,
+			 ztest_unit_test(test_replay),
+			 ztest_unit_test(test_local),
+			 ztest_unit_test(test_match),
+			 ztest_unit_test(test_iv_update),
+			 ztest_unit_test(test_full),
+			 ztest_unit_test(test_benchmark)
+			 );
+
+	ztest_run_test_suite(bt_mesh_rpl_test);
+}
@@ -862,6 +862,65 @@ static void test_any_day_month_gap(void)
 	expected_tm_check(&expected, 1);
 }
 
+static void test_any_day_week_leap_year(void)
+{
+	const struct bt_mesh_schedule_entry test_action = {
+			.year = BT_MESH_SCHEDULER_ANY_YEAR,
+			.month  = BT_MESH_SCHEDULER_FEB | BT_MESH_SCHEDULER_MAR,
+			.day = BT_MESH_SCHEDULER_ANY_DAY,
+			.hour = 0,
+			.minute = 0,
+			.second = 0,
+			.day_of_week = BT_MESH_SCHEDULER_WED | BT_MESH_SCHEDULER_THU,
+			.action = BT_MESH_SCHEDULER_SCENE_RECALL,
+			.transition_time = 0,
+			.scene_number = 1
+	};
+
+	/* 27th of Feb 2012 - Monday */
+	start_tm.tm_year = 112;
+	start_tm.tm_mon = 1;
+	start_tm.tm_mday = 27;
+
+	action_put(&test_action);
+	measurement_start(60ll * 60ll * 24ll * 3ll, 2);
+
+	struct tm expected[2] = {
+		{ISTM(112, 1, 29, 0, 0, 0)},
+		{ISTM(112, 2, 1, 0, 0, 0)}
+	};
+
+	expected_tm_check(expected, 2);
+}
+
+static void test_exact_day_week_month_gap(void)
+{
+	const struct bt_mesh_schedule_entry test_action = {
+			.year = BT_MESH_SCHEDULER_ANY_YEAR,
+			.month  = ANY_MONTH,
+			.day = 1,
+			.hour = 0,
+			.minute = 0,
+			.second = 0,
+			.day_of_week = BT_MESH_SCHEDULER_SUN,
+			.action = BT_MESH_SCHEDULER_SCENE_RECALL,
+			.transition_time = 0,
+			.scene_number = 1
+	};
+
+	/* 1st of Aug 2010 is the first Sunday to start a month after Jan 2nd */
+	start_tm.tm_mday = 2;
+
+	action_put(&test_action);
+	measurement_start(60ll * 60ll * 24ll * 212ll, 1);
+
+	struct tm expected = {
+		ISTM(110, 7, 1, 0, 0, 0)
+	};
+
+	expected_tm_check(&expected, 1);
+}
+
 static void test_month_ovflw(void)
 {
 	const struct bt_mesh_schedule_entry test_action = {
@@ -947,6 +1006,8 @@ void test_main(void)
 		ztest_unit_test_setup_teardown(test_any_day_week_gap_ovflw_next_month,
 				setup, teardown),
 		ztest_unit_test_setup_teardown(test_any_day_month_gap, setup, teardown),
+		ztest_unit_test_setup_teardown(test_any_day_week_leap_year, setup, teardown),
+		ztest_unit_test_setup_teardown(test_exact_day_week_month_gap, setup, teardown),
 		ztest_unit_test_setup_teardown(test_month_ovflw, setup, teardown),
 		ztest_unit_test_setup_teardown(test_exact_time_general_ovflw, setup, teardown)
 		);
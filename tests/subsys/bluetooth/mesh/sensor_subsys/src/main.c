@@ -2437,9 +2437,34 @@ static void test_present_rel_output_ripple_voltage(void)
 	percentage8_check(sensor_type);
 }
 
+static void test_sensor_type_get(void)
+{
+	const struct bt_mesh_sensor_type *prev = NULL;
+	size_t cnt = 0;
+
+	STRUCT_SECTION_FOREACH(bt_mesh_sensor_type, type) {
+		if (prev) {
+			zassert_true(prev->id < type->id,
+				     "Sensor types not sorted: 0x%04x before 0x%04x",
+				     prev->id, type->id);
+		}
+
+		zassert_equal_ptr(bt_mesh_sensor_type_get(type->id), type,
+				  "Wrong sensor type for 0x%04x", type->id);
+		prev = type;
+		cnt++;
+	}
+
+	zassert_true(cnt > 0, "No sensor types");
+	zassert_is_null(bt_mesh_sensor_type_get(0x0000), "Prohibited ID found");
+	zassert_is_null(bt_mesh_sensor_type_get(0xffff), "Unknown ID found");
+}
+
 void test_main(void)
 {
 	ztest_test_suite(sensor_types_test,
+			ztest_unit_test(test_sensor_type_get),
+
 			/* Occupancy sensors */
 			ztest_unit_test(test_motion_sensor),
 			ztest_unit_test(test_motion_threshold),
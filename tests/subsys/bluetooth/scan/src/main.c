@@ -0,0 +1,385 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <bluetooth/scan.h>
+
+/* Replayed advertising stream. Every report carries flags and a complete
+ * name. Every fourth report also lists three 16-bit service UUIDs, and
+ * every other report carries manufacturer data.
+ */
+#define REPORT_CNT		256
+#define REPORT_MAX_LEN		31
+#define UUIDS_PER_LIST		3
+#define UUID_LIST_CNT		(REPORT_CNT / 4)
+#define TIMING_REPEAT		100
+
+#define COMPANY_ID		0x0059
+#define UUID_HRS		0x180D
+#define UUID_BAS		0x180F
+#define UUID_DIS		0x180A
+#define UUID_CSCS		0x1816
+#define UUID_DEVICE_NAME	0x2A00
+
+#define UUID_16_SIZE		sizeof(uint16_t)
+#define UUID_32_SIZE		sizeof(uint32_t)
+#define UUID_128_SIZE		16
+
+struct adv_report {
+	bt_addr_le_t addr;
+	uint8_t data[REPORT_MAX_LEN];
+	uint8_t len;
+};
+
+static struct adv_report reports[REPORT_CNT];
+static struct bt_le_scan_cb *scan_cb;
+
+/* Work done by the library while filtering, counted by the mocks. */
+static struct {
+	uint32_t parse;
+	uint32_t ad;
+	uint32_t uuid_create;
+	uint32_t match;
+	uint32_t no_match;
+} cnt;
+
+/* redefined mocks */
+void bt_le_scan_cb_register(struct bt_le_scan_cb *cb)
+{
+	scan_cb = cb;
+}
+
+int bt_le_scan_start(const struct bt_le_scan_param *param, bt_le_scan_cb_t cb)
+{
+	return 0;
+}
+
+int bt_le_scan_stop(void)
+{
+	return 0;
+}
+
+void bt_data_parse(struct net_buf_simple *ad,
+		   bool (*func)(struct bt_data *data, void *user_data),
+		   void *user_data)
+{
+	cnt.parse++;
+
+	while (ad->len > 1) {
+		struct bt_data data;
+		uint8_t len = net_buf_simple_pull_u8(ad);
+
+		if (len == 0U || len > ad->len) {
+			return;
+		}
+
+		data.type = net_buf_simple_pull_u8(ad);
+		data.data_len = len - 1;
+		data.data = ad->data;
+		cnt.ad++;
+
+		if (!func(&data, user_data)) {
+			return;
+		}
+
+		net_buf_simple_pull(ad, len - 1);
+	}
+}
+
+bool bt_uuid_create(struct bt_uuid *uuid, const uint8_t *data, uint8_t data_len)
+{
+	cnt.uuid_create++;
+
+	switch (data_len) {
+	case UUID_16_SIZE:
+		uuid->type = BT_UUID_TYPE_16;
+		BT_UUID_16(uuid)->val = sys_get_le16(data);
+		return true;
+	case UUID_32_SIZE:
+		uuid->type = BT_UUID_TYPE_32;
+		BT_UUID_32(uuid)->val = sys_get_le32(data);
+		return true;
+	case UUID_128_SIZE:
+		uuid->type = BT_UUID_TYPE_128;
+		memcpy(BT_UUID_128(uuid)->val, data, UUID_128_SIZE);
+		return true;
+	default:
+		return false;
+	}
+}
+
+static void uuid_to_uuid128(const struct bt_uuid *src, struct bt_uuid_128 *dst)
+{
+	*dst = (struct bt_uuid_128)BT_UUID_INIT_128(
+		BT_UUID_128_ENCODE(0x00000000, 0x0000, 0x1000, 0x8000, 0x00805F9B34FB));
+
+	switch (src->type) {
+	case BT_UUID_TYPE_16:
+		sys_put_le16(BT_UUID_16(src)->val, &dst->val[12]);
+		break;
+	case BT_UUID_TYPE_32:
+		sys_put_le32(BT_UUID_32(src)->val, &dst->val[12]);
+		break;
+	case BT_UUID_TYPE_128:
+		*dst = *BT_UUID_128(src);
+		break;
+	}
+}
+
+int bt_uuid_cmp(const struct bt_uuid *u1, const struct bt_uuid *u2)
+{
+	struct bt_uuid_128 uuid1;
+	struct bt_uuid_128 uuid2;
+
+	uuid_to_uuid128(u1, &uuid1);
+	uuid_to_uuid128(u2, &uuid2);
+
+	return memcmp(uuid1.val, uuid2.val, sizeof(uuid1.val));
+}
+/* redefined mocks */
+
+static void filter_match(struct bt_scan_device_info *device_info,
+			 struct bt_scan_filter_match *filter_match,
+			 bool connectable)
+{
+	cnt.match++;
+}
+
+static void filter_no_match(struct bt_scan_device_info *device_info,
+			    bool connectable)
+{
+	cnt.no_match++;
+}
+
+BT_SCAN_CB_INIT(scan_cbs, filter_match, filter_no_match, NULL, NULL);
+
+static uint8_t ad_put(uint8_t *buf, uint8_t type, const uint8_t *data,
+		      uint8_t len)
+{
+	buf[0] = len + 1;
+	buf[1] = type;
+	memcpy(&buf[2], data, len);
+
+	return len + 2;
+}
+
+static void report_addr(size_t idx, bt_addr_le_t *addr)
+{
+	addr->type = BT_ADDR_LE_RANDOM;
+	memset(addr->a.val, 0, sizeof(addr->a.val));
+	sys_put_le16(idx, addr->a.val);
+	/* Static random address. */
+	addr->a.val[5] = 0xC0;
+}
+
+static void stream_generate(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(reports); i++) {
+		struct adv_report *r = &reports[i];
+		uint8_t flags = BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR;
+		char name[8];
+		uint8_t *p = r->data;
+
+		report_addr(i, &r->addr);
+
+		p += ad_put(p, BT_DATA_FLAGS, &flags, sizeof(flags));
+
+		(void)snprintf(name, sizeof(name), "dev%03u", (unsigned int)i);
+		p += ad_put(p, BT_DATA_NAME_COMPLETE, (const uint8_t *)name,
+			     strlen(name));
+
+		if ((i % 4) == 0) {
+			uint8_t uuids[UUIDS_PER_LIST * UUID_16_SIZE];
+
+			sys_put_le16(UUID_BAS, &uuids[0]);
+			sys_put_le16(UUID_DIS, &uuids[2]);
+			sys_put_le16((i % 8) == 0 ? UUID_HRS : UUID_CSCS, &uuids[4]);
+			p += ad_put(p, BT_DATA_UUID16_ALL, uuids, sizeof(uuids));
+		}
+
+		if ((i % 2) == 0) {
+			uint8_t md[3];
+
+			sys_put_le16(COMPANY_ID, md);
+			md[2] = i;
+			p += ad_put(p, BT_DATA_MANUFACTURER_DATA, md, sizeof(md));
+		}
+
+		r->len = p - r->data;
+		zassert_true(r->len <= REPORT_MAX_LEN, "Report too long");
+	}
+}
+
+static void stream_replay(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(reports); i++) {
+		struct adv_report *r = &reports[i];
+		struct bt_le_scan_recv_info info = {
+			.addr = &r->addr,
+			.adv_props = BT_GAP_ADV_PROP_CONNECTABLE |
+				     BT_GAP_ADV_PROP_SCANNABLE,
+		};
+		struct net_buf_simple ad;
+
+		net_buf_simple_init_with_data(&ad, r->data, r->len);
+		scan_cb->recv(&info, &ad);
+	}
+}
+
+/* Replay the stream once to count the work done by the library, then
+ * replay it repeatedly to measure the time spent per report. CPU time is
+ * not simulated on native_posix, so the timing is only meaningful when the
+ * test is run on hardware.
+ */
+static void benchmark_run(const char *scenario)
+{
+	memset(&cnt, 0, sizeof(cnt));
+	stream_replay();
+
+	__typeof__(cnt) replay_cnt = cnt;
+	uint32_t start = k_cycle_get_32();
+
+	for (size_t i = 0; i < TIMING_REPEAT; i++) {
+		stream_replay();
+	}
+
+	uint32_t ns = k_cyc_to_ns_floor64(k_cycle_get_32() - start) /
+		      (TIMING_REPEAT * REPORT_CNT);
+
+	cnt = replay_cnt;
+
+	TC_PRINT("%s: %u ns/report, %u parsed, %u AD structures, %u UUIDs\n",
+		 scenario, ns, cnt.parse, cnt.ad, cnt.uuid_create);
+}
+
+static void setup(void)
+{
+	bt_scan_init(NULL);
+	bt_scan_filter_remove_all();
+	bt_scan_blocklist_clear();
+}
+
+static void teardown(void)
+{
+	bt_scan_filter_disable();
+}
+
+static void test_no_filter(void)
+{
+	benchmark_run("no filter");
+
+	zassert_equal(cnt.no_match, REPORT_CNT, "All reports must be reported");
+	zassert_equal(cnt.parse, 0, "Advertising data parsed without a filter");
+}
+
+static void test_addr_filter(void)
+{
+	bt_addr_le_t addr[2];
+
+	report_addr(5, &addr[0]);
+	report_addr(200, &addr[1]);
+
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_ADDR, &addr[0]), NULL);
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_ADDR, &addr[1]), NULL);
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_ADDR_FILTER, false), NULL);
+
+	benchmark_run("address");
+
+	zassert_equal(cnt.match, 2, "Wrong number of matches");
+	zassert_equal(cnt.parse, 0,
+		      "Advertising data parsed for address filter only");
+}
+
+static void test_blocklist(void)
+{
+	bt_addr_le_t addr;
+
+	report_addr(7, &addr);
+
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_NAME, "dev007"), NULL);
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_NAME_FILTER, false), NULL);
+	zassert_ok(bt_scan_blocklist_device_add(&addr), NULL);
+
+	benchmark_run("name, blocklist");
+
+	zassert_equal(cnt.match, 0, "Blocklisted device reported");
+	zassert_equal(cnt.no_match, REPORT_CNT - 1, "Wrong number of reports");
+	zassert_equal(cnt.parse, REPORT_CNT - 1,
+		      "Blocklisted device advertising data parsed");
+}
+
+static void test_uuid_filter(void)
+{
+	const struct bt_uuid_16 uuid[] = {
+		BT_UUID_INIT_16(UUID_HRS),
+		BT_UUID_INIT_16(UUID_CSCS),
+		BT_UUID_INIT_16(UUID_DEVICE_NAME),
+	};
+
+	for (size_t i = 0; i < ARRAY_SIZE(uuid); i++) {
+		zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, &uuid[i].uuid),
+			   NULL);
+	}
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_UUID_FILTER, false), NULL);
+
+	benchmark_run("UUID");
+
+	zassert_equal(cnt.match, UUID_LIST_CNT, "Wrong number of matches");
+	/* Each advertised UUID is decoded once, regardless of the number of
+	 * UUID filters.
+	 */
+	zassert_equal(cnt.uuid_create, UUID_LIST_CNT * UUIDS_PER_LIST,
+		      "Advertised UUIDs decoded more than once");
+}
+
+static void test_multi_filter_match_all(void)
+{
+	const struct bt_uuid_16 uuid = BT_UUID_INIT_16(UUID_HRS);
+	uint8_t md_data[2];
+	const struct bt_scan_manufacturer_data md = {
+		.data = md_data,
+		.data_len = sizeof(md_data),
+	};
+
+	sys_put_le16(COMPANY_ID, md_data);
+
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, &uuid.uuid), NULL);
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_MANUFACTURER_DATA, &md),
+		   NULL);
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_UUID_FILTER |
+					 BT_SCAN_MANUFACTURER_DATA_FILTER, true),
+		   NULL);
+
+	benchmark_run("UUID and manufacturer data, match all");
+
+	zassert_equal(cnt.match, UUID_LIST_CNT / 2, "Wrong number of matches");
+	zassert_equal(cnt.no_match, REPORT_CNT - UUID_LIST_CNT / 2,
+		      "Wrong number of reports");
+	zassert_equal(cnt.parse, REPORT_CNT, "Wrong number of parsed reports");
+}
+
+void test_main(void)
+{
+	stream_generate();
+	bt_scan_init(NULL);
+	bt_scan_cb_register(&scan_cbs);
+	zassert_not_null(scan_cb, "Scan callback not registered");
+
+	ztest_test_suite(bt_scan_benchmark,
+		ztest_unit_test_setup_teardown(test_no_filter, setup, teardown),
+		ztest_unit_test_setup_teardown(test_addr_filter, setup, teardown),
+		ztest_unit_test_setup_teardown(test_blocklist, setup, teardown),
+		ztest_unit_test_setup_teardown(test_uuid_filter, setup, teardown),
+		ztest_unit_test_setup_teardown(test_multi_filter_match_all,
+					       setup, teardown)
+		);
+
+	ztest_run_test_suite(bt_scan_benchmark);
+}
@@ -56,4 +56,13 @@ static const struct sm_sensor_config sensor_configs[] = {
 		.sampling_period_ms = 33000,
 		.active_events_limit = 3,
 	},
+	{
+		.dev = DEVICE_DT_GET(DT_NODELABEL(sensor_sim_4)),
+		.event_descr = "Simulated sensor 4",
+		.chans = accel_chan,
+		.chan_cnt = ARRAY_SIZE(accel_chan),
+		.sampling_period_ms = 10,
+		.batch_size = 5,
+		.active_events_limit = 3,
+	},
 };
@@ -20,6 +20,11 @@ LOG_MODULE_REGISTER(MODULE);
 
 #define PRE_CHANGE_SAMPLING_PERIOD 20
 #define SAMPLING_PERIOD 40
+#define BATCH_SAMPLING_PERIOD 10
+#define BATCH_SIZE 5
+#define BATCH_VALUE_CNT 3
+/* The simulated wave has an amplitude of 0.5 and a noise of 0.1, with no offset. */
+#define BATCH_VAL_LIMIT 600
 
 static enum test_id cur_test_id;
 static K_SEM_DEFINE(test_end_sem, 0, 1);
@@ -90,6 +95,29 @@ static void test_multiple_sensors(void)
 	test_start(TEST_MULTIPLE_SENSORS);
 }
 
+static void test_batch(void)
+{
+	test_start(TEST_BATCH);
+}
+
+static void test_batch_val_conversion(void)
+{
+	struct sensor_value val = {.val1 = -2, .val2 = -500000};
+
+	zassert_equal(sensor_value_to_batch_val(val), -2500, "Wrong batch value");
+
+	val = sensor_value_from_batch_val(-2500);
+	zassert_equal(val.val1, -2, "Wrong integer part");
+	zassert_equal(val.val2, -500000, "Wrong fractional part");
+
+	val.val1 = INT32_MAX / SENSOR_BATCH_VAL_SCALE + 1;
+	val.val2 = 0;
+	zassert_equal(sensor_value_to_batch_val(val), INT32_MAX, "Value not clamped");
+
+	val.val1 = INT32_MIN / SENSOR_BATCH_VAL_SCALE - 1;
+	zassert_equal(sensor_value_to_batch_val(val), INT32_MIN, "Value not clamped");
+}
+
 void test_main(void)
 {
 	ztest_test_suite(caf_sensor_aggregator_tests,
@@ -98,7 +126,9 @@ void test_main(void)
 			 ztest_unit_test(test_basic),
 			 ztest_unit_test(test_change_period_pre),
 			 ztest_unit_test(test_change_period_post),
-			 ztest_unit_test(test_multiple_sensors)
+			 ztest_unit_test(test_multiple_sensors),
+			 ztest_unit_test(test_batch),
+			 ztest_unit_test(test_batch_val_conversion)
 			 );
 
 	ztest_run_test_suite(caf_sensor_aggregator_tests);
@@ -207,6 +237,59 @@ static bool app_event_handler(const struct app_event_header *aeh)
 		return false;
 	}
 
+	if (is_sensor_batch_event(aeh)) {
+		struct sensor_batch_event *ev = cast_sensor_batch_event(aeh);
+
+		zassert_false(strcmp(ev->descr, "Simulated sensor 4"),
+			      "Expected sensor 4 batch event");
+		zassert_equal(ev->sample_cnt, BATCH_SIZE, "Wrong number of samples");
+		zassert_equal(ev->value_cnt, BATCH_VALUE_CNT, "Wrong number of values");
+
+		if (cur_test_id != TEST_BATCH) {
+			return false;
+		}
+
+		const uint32_t *words = (const uint32_t *)ev->dyndata.data;
+		size_t sample_words = sensor_batch_sample_word_cnt(BATCH_VALUE_CNT);
+
+		zassert_equal(ev->dyndata.size,
+			      BATCH_SIZE * sample_words * sizeof(uint32_t),
+			      "Wrong batch size");
+		zassert_equal(sensor_batch_event_get_sample_time(ev, 0), 0,
+			      "First sample must start the batch");
+
+		for (size_t i = 0; i < ev->sample_cnt; i++) {
+			uint32_t offset = sensor_batch_event_get_sample_time(ev, i);
+			const int32_t *values = sensor_batch_event_get_sample_values(ev, i);
+
+			/* Every sample is a time offset followed by its values. */
+			zassert_equal(offset, words[i * sample_words], "Wrong sample layout");
+			zassert_equal_ptr(values, &words[i * sample_words + 1],
+					  "Wrong sample layout");
+
+			if (i > 0) {
+				zassert_between_inclusive(offset,
+						(i * BATCH_SAMPLING_PERIOD - 1) * USEC_PER_MSEC,
+						(i * BATCH_SAMPLING_PERIOD + 1) * USEC_PER_MSEC,
+						"Wrong sample time");
+			}
+
+			for (size_t j = 0; j < BATCH_VALUE_CNT; j++) {
+				zassert_between_inclusive(values[j], -BATCH_VAL_LIMIT,
+							  BATCH_VAL_LIMIT,
+							  "Sample value out of range");
+			}
+		}
+
+		zassert_true(ev->jitter_avg <= ev->jitter_max, "Inconsistent jitter statistics");
+		zassert_true(ev->jitter_max <= USEC_PER_MSEC, "Sampling jitter too high");
+
+		cur_test_id = TEST_IDLE;
+		k_sem_give(&test_end_sem);
+
+		return false;
+	}
+
 	zassert_unreachable("Wrong event type received");
 	return false;
 }
@@ -214,3 +297,4 @@ static bool app_event_handler(const struct app_event_header *aeh)
 APP_EVENT_LISTENER(test_main, app_event_handler);
 APP_EVENT_SUBSCRIBE(test_main, test_end_event);
 APP_EVENT_SUBSCRIBE(test_main, sensor_event);
+APP_EVENT_SUBSCRIBE(test_main, sensor_batch_event);
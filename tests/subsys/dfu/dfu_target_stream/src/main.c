@@ -11,6 +11,14 @@
 #include <zephyr/ztest.h>
 #include <dfu/dfu_target_stream.h>
 
+#ifdef CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS
+#include <zephyr/settings/settings.h>
+#endif
+
+#ifdef CONFIG_DFU_TARGET_STREAM_HASH
+#include <mbedtls/sha256.h>
+#endif
+
 #define FLASH_BASE (64*1024)
 #define FLASH_SIZE DT_REG_SIZE(SOC_NV_FLASH_NODE)
 #define FLASH_AVAILABLE (FLASH_SIZE-FLASH_BASE)
@@ -251,6 +259,117 @@ static void test_dfu_target_stream_save_progress(void)
 		      "Expected last erased page offset to be unchanged.");
 }
 
+/* Linked with --wrap=settings_save_one, see CMakeLists.txt. */
+int __real_settings_save_one(const char *name, const void *value,
+			     size_t val_len);
+
+static size_t settings_save_cnt;
+
+int __wrap_settings_save_one(const char *name, const void *value,
+			     size_t val_len)
+{
+	settings_save_cnt++;
+
+	return __real_settings_save_one(name, value, val_len);
+}
+
+static int stored_offset_load(const char *key, size_t len,
+			      settings_read_cb read_cb, void *cb_arg,
+			      void *param)
+{
+	ssize_t rc = read_cb(cb_arg, param, sizeof(size_t));
+
+	return (rc == sizeof(size_t)) ? 0 : -EINVAL;
+}
+
+static void test_dfu_target_stream_save_progress_small_chunks(void)
+{
+	int err;
+	size_t offset;
+	size_t prev_offset = 0;
+	size_t flush_cnt = 0;
+	size_t write_cnt = 0;
+	size_t resumed_offset;
+	size_t chunk = sizeof(sbuf) / 8;
+
+	/* Reset state to avoid failure when initializing */
+	err = dfu_target_stream_done(true);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = DFU_TARGET_STREAM_INIT(TEST_ID_1, fdev, sbuf, sizeof(sbuf),
+				     FLASH_BASE, 0, NULL);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	settings_save_cnt = 0;
+
+	/* Write in chunks smaller than the stream buffer. The progress only
+	 * changes when the buffer is flushed to flash, and it must be stored
+	 * exactly once per flush.
+	 */
+	for (size_t i = 0; i + chunk <= BUF_LEN / 2; i += chunk) {
+		err = dfu_target_stream_write(&write_buf[i], chunk);
+		zassert_equal(err, 0, "Unexpected failure: %d", err);
+		write_cnt++;
+
+		err = dfu_target_stream_offset_get(&offset);
+		zassert_equal(err, 0, "Unexpected failure: %d", err);
+		zassert_equal(offset % sizeof(sbuf), 0, "Unaligned offset");
+		zassert_true(offset <= i + chunk, "Invalid offset");
+
+		if (offset != prev_offset) {
+			flush_cnt++;
+			prev_offset = offset;
+		}
+
+		zassert_equal(settings_save_cnt, flush_cnt,
+			      "Progress stored %zu times for %zu flushes",
+			      settings_save_cnt, flush_cnt);
+	}
+
+	zassert_not_equal(flush_cnt, 0, "Stream buffer never flushed");
+	zassert_true(settings_save_cnt < write_cnt,
+		     "Progress stored on every write");
+
+	/* Writes that do not flush the buffer must not store the progress. */
+	err = dfu_target_stream_write(write_buf, 0);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+	zassert_equal(settings_save_cnt, flush_cnt, "Unchanged progress stored");
+
+	err = dfu_target_stream_offset_get(&offset);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+	zassert_not_equal(offset, 0, "Offset not updated");
+
+	/* Interrupt the transfer between two buffer flushes. The progress is
+	 * already stored, so it is not stored again.
+	 */
+	err = dfu_target_stream_done(false);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+	zassert_equal(settings_save_cnt, flush_cnt, "Unchanged progress stored");
+
+	/* The progress stored on the last flush must match the offset. */
+	resumed_offset = 0;
+	err = settings_load_subtree_direct("dfu/" TEST_ID_1, stored_offset_load,
+					   &resumed_offset);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+	zassert_equal(offset, resumed_offset, "Offsets do not match");
+
+	/* Resuming the stream loads the progress without storing it. */
+	err = DFU_TARGET_STREAM_INIT(TEST_ID_1, fdev, sbuf, sizeof(sbuf),
+				     FLASH_BASE, 0, NULL);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = dfu_target_stream_done(false);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+	zassert_equal(settings_save_cnt, flush_cnt, "Unchanged progress stored");
+
+	err = DFU_TARGET_STREAM_INIT(TEST_ID_1, fdev, sbuf, sizeof(sbuf),
+				     FLASH_BASE, 0, NULL);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = dfu_target_stream_done(true);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+}
+
 static size_t get_flash_page_size(const struct device *dev)
 {
 	struct flash_driver_api *api = (struct flash_driver_api *) dev->api;
@@ -279,8 +398,129 @@ static void test_dfu_target_stream_save_progress(void)
 	ztest_test_skip();
 }
 
+static void test_dfu_target_stream_save_progress_small_chunks(void)
+{
+	ztest_test_skip();
+}
+
 #endif
 
+#ifdef CONFIG_DFU_TARGET_STREAM_HASH
+static void test_dfu_target_stream_hash(void)
+{
+	int err;
+	uint8_t hash[32];
+	uint8_t expected[32];
+
+	/* Reset state to avoid failure when initializing */
+	err = dfu_target_stream_done(true);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = DFU_TARGET_STREAM_INIT(TEST_ID_1, fdev, sbuf, sizeof(sbuf),
+				     FLASH_BASE, 0, NULL);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = dfu_target_stream_write(write_buf, BUF_LEN / 2);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	/* The digest is not available before the stream is completed */
+	err = dfu_target_stream_hash_get(hash, sizeof(hash));
+	zassert_equal(err, -EACCES, "Unexpected result: %d", err);
+
+	err = dfu_target_stream_write(&write_buf[BUF_LEN / 2],
+				      BUF_LEN - BUF_LEN / 2);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = dfu_target_stream_done(true);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = dfu_target_stream_hash_get(hash, sizeof(hash) - 1);
+	zassert_equal(err, -ENOMEM, "Unexpected result: %d", err);
+
+	err = dfu_target_stream_hash_get(hash, sizeof(hash));
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = mbedtls_sha256(write_buf, BUF_LEN, expected, false);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+	zassert_mem_equal(hash, expected, sizeof(hash), "Incorrect digest");
+
+	/* Aborting a stream invalidates the digest */
+	err = DFU_TARGET_STREAM_INIT(TEST_ID_1, fdev, sbuf, sizeof(sbuf),
+				     FLASH_BASE, 0, NULL);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = dfu_target_stream_done(false);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = dfu_target_stream_hash_get(hash, sizeof(hash));
+	zassert_equal(err, -EACCES, "Unexpected result: %d", err);
+}
+#else
+
+static void test_dfu_target_stream_hash(void)
+{
+	ztest_test_skip();
+}
+
+#endif
+
+#if defined(CONFIG_DFU_TARGET_STREAM_HASH) && defined(CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS)
+static void test_dfu_target_stream_hash_resume(void)
+{
+	int err;
+	size_t offset;
+	uint8_t hash[32];
+	uint8_t expected[32];
+
+	/* Reset state to avoid failure when initializing */
+	err = dfu_target_stream_done(true);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = DFU_TARGET_STREAM_INIT(TEST_ID_1, fdev, sbuf, sizeof(sbuf),
+				     FLASH_BASE, 0, NULL);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = dfu_target_stream_write(write_buf, BUF_LEN / 2);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	/* Interrupt the transfer. Data that was not flushed is lost. */
+	err = dfu_target_stream_done(false);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	/* Resuming reloads the progress and hashes the flushed data back
+	 * from flash.
+	 */
+	err = DFU_TARGET_STREAM_INIT(TEST_ID_1, fdev, sbuf, sizeof(sbuf),
+				     FLASH_BASE, 0, NULL);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = dfu_target_stream_offset_get(&offset);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+	zassert_not_equal(offset, 0, "Progress not resumed");
+	zassert_true(offset <= BUF_LEN / 2, "Invalid offset");
+
+	err = dfu_target_stream_write(&write_buf[offset], BUF_LEN - offset);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = dfu_target_stream_done(true);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = dfu_target_stream_hash_get(hash, sizeof(hash));
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	/* The digest must match the one of the image written in one pass. */
+	err = mbedtls_sha256(write_buf, BUF_LEN, expected, false);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+	zassert_mem_equal(hash, expected, sizeof(hash), "Incorrect digest");
+}
+#else
+
+static void test_dfu_target_stream_hash_resume(void)
+{
+	ztest_test_skip();
+}
+
+#endif
 
 void test_main(void)
 {
@@ -300,7 +540,10 @@ void test_main(void)
 	ztest_test_suite(lib_dfu_target_stream,
 	     ztest_unit_test(test_dfu_target_stream_null_checks),
 	     ztest_unit_test(test_dfu_target_stream),
-	     ztest_unit_test(test_dfu_target_stream_save_progress)
+	     ztest_unit_test(test_dfu_target_stream_save_progress),
+	     ztest_unit_test(test_dfu_target_stream_save_progress_small_chunks),
+	     ztest_unit_test(test_dfu_target_stream_hash),
+	     ztest_unit_test(test_dfu_target_stream_hash_resume)
 	 );
 
 	ztest_run_test_suite(lib_dfu_target_stream);
@@ -7,9 +7,14 @@
 #include <unity.h>
 #include <zephyr/kernel.h>
 #include <stdio.h>
+#include <string.h>
 #include <net/nrf_cloud.h>
 #include <mock_nrf_cloud_transport.h>
 #include "nrf_cloud_fsm.h"
+#include "nrf_cloud_outbox.h"
+#if defined(CONFIG_NRF_CLOUD_OUTBOX_PERSISTENT)
+#include <zephyr/settings/settings.h>
+#endif
 
 /* This is required since unity_main return int and
  * zephyr expects main not to return any value
@@ -177,6 +182,218 @@ void test_init_fota_failed(void)
 #endif
 }
 
+/* Messages published by the outbox, in the order they were published */
+static struct {
+	char topic; /* 'B' bulk, 'D' message with QoS 1, 'S' message with QoS 0 */
+	char data[128];
+	size_t len;
+} published[32];
+static int published_cnt;
+/* Index of the publish attempt that fails, or -1 */
+static int publish_fail_at;
+static int publish_attempts;
+
+static int publish_log(char topic, const struct nct_dc_data *dc)
+{
+	if (publish_attempts++ == publish_fail_at) {
+		return -EIO;
+	}
+
+	TEST_ASSERT_LESS_THAN(ARRAY_SIZE(published), published_cnt);
+	TEST_ASSERT_LESS_OR_EQUAL(sizeof(published[0].data), dc->data.len);
+
+	published[published_cnt].topic = topic;
+	published[published_cnt].len = dc->data.len;
+	memcpy(published[published_cnt].data, dc->data.ptr, dc->data.len);
+	published_cnt++;
+
+	return 0;
+}
+
+static int dc_bulk_send_stub(const struct nct_dc_data *dc_data, enum mqtt_qos qos,
+			     int num_calls)
+{
+	return publish_log('B', dc_data);
+}
+
+static int dc_send_stub(const struct nct_dc_data *dc, int num_calls)
+{
+	return publish_log('D', dc);
+}
+
+static int dc_stream_stub(const struct nct_dc_data *dc, int num_calls)
+{
+	return publish_log('S', dc);
+}
+
+static void outbox_setup(void)
+{
+	published_cnt = 0;
+	publish_attempts = 0;
+	publish_fail_at = -1;
+
+	__wrap_nct_dc_bulk_send_Stub(dc_bulk_send_stub);
+	__wrap_nct_dc_send_Stub(dc_send_stub);
+	__wrap_nct_dc_stream_Stub(dc_stream_stub);
+
+	TEST_ASSERT_FALSE_MESSAGE(nct_outbox_pending(), "outbox should be empty at the start");
+}
+
+static void outbox_put(enum nrf_cloud_topic_type topic, const char *data)
+{
+	const struct nrf_cloud_tx_data msg = {
+		.data.ptr = data,
+		.data.len = strlen(data),
+		.topic_type = topic,
+		.qos = MQTT_QOS_0_AT_MOST_ONCE,
+	};
+
+	TEST_ASSERT_EQUAL_MESSAGE(0, nct_outbox_put(&msg), "message should be queued");
+}
+
+static void assert_published(int idx, char topic, const char *data)
+{
+	TEST_ASSERT_EQUAL_CHAR(topic, published[idx].topic);
+	TEST_ASSERT_EQUAL(strlen(data), published[idx].len);
+	TEST_ASSERT_EQUAL_MEMORY(data, published[idx].data, published[idx].len);
+}
+
+/* Verify that the oldest messages are dropped when the outbox is full,
+ * and that the remaining ones are sent in order
+ */
+void test_outbox_drop_oldest(void)
+{
+	const int msg_cnt = 20;
+	struct nrf_cloud_outbox_stats before;
+	struct nrf_cloud_outbox_stats after;
+	char data[101];
+	int first;
+
+	outbox_setup();
+	(void)nrf_cloud_outbox_stats_get(&before);
+
+	for (int i = 0; i < msg_cnt; i++) {
+		memset(data, 'x', sizeof(data) - 1);
+		data[sizeof(data) - 1] = '\0';
+		data[snprintf(data, sizeof(data), "%03d", i)] = 'x';
+		outbox_put(NRF_CLOUD_TOPIC_BULK, data);
+	}
+
+	(void)nrf_cloud_outbox_stats_get(&after);
+	TEST_ASSERT_GREATER_THAN_MESSAGE(0, after.dropped_msgs - before.dropped_msgs,
+		"messages should be dropped when the outbox is full");
+	TEST_ASSERT_EQUAL(msg_cnt, after.queued_msgs + after.dropped_msgs - before.dropped_msgs);
+
+	TEST_ASSERT_EQUAL(0, nct_outbox_flush());
+	TEST_ASSERT_EQUAL(after.queued_msgs, published_cnt);
+
+	first = msg_cnt - published_cnt;
+	for (int i = 0; i < published_cnt; i++) {
+		snprintf(data, sizeof(data), "%03d", first + i);
+		TEST_ASSERT_EQUAL_CHAR('B', published[i].topic);
+		TEST_ASSERT_EQUAL_MEMORY(data, published[i].data, 3);
+	}
+
+	TEST_ASSERT_FALSE(nct_outbox_pending());
+}
+
+/* Verify that JSON object messages are coalesced into bulk batches that are
+ * split at CONFIG_NRF_CLOUD_OUTBOX_BATCH_SIZE, and that other messages keep their topic
+ */
+void test_outbox_batch_split(void)
+{
+	struct nrf_cloud_outbox_stats stats;
+	char data[16];
+
+	outbox_setup();
+
+	for (int i = 0; i < 9; i++) {
+		snprintf(data, sizeof(data), "{\"n\":%d}", i);
+		outbox_put(NRF_CLOUD_TOPIC_MESSAGE, data);
+	}
+	outbox_put(NRF_CLOUD_TOPIC_MESSAGE, "[1]");
+	outbox_put(NRF_CLOUD_TOPIC_MESSAGE, "{\"n\":9}");
+
+	TEST_ASSERT_EQUAL(0, nct_outbox_flush());
+	TEST_ASSERT_EQUAL(4, published_cnt);
+
+	/* 7 messages of 7 bytes fill a 64 byte batch */
+	assert_published(0, 'B', "[{\"n\":0},{\"n\":1},{\"n\":2},{\"n\":3},"
+				 "{\"n\":4},{\"n\":5},{\"n\":6}]");
+	assert_published(1, 'B', "[{\"n\":7},{\"n\":8}]");
+	/* Not a JSON object, sent to the message topic */
+	assert_published(2, 'S', "[1]");
+	/* A batch of one is sent unchanged */
+	assert_published(3, 'S', "{\"n\":9}");
+
+	(void)nrf_cloud_outbox_stats_get(&stats);
+	TEST_ASSERT_EQUAL(11, stats.last_flush_msgs);
+	TEST_ASSERT_EQUAL(4, stats.last_flush_publishes);
+	TEST_ASSERT_EQUAL(0, stats.queued_msgs);
+}
+
+/* Verify that a failed publish keeps the unsent messages queued, and that they are
+ * sent once, in order, by the next flush
+ */
+void test_outbox_retry_on_failure(void)
+{
+	struct nrf_cloud_outbox_stats stats;
+
+	outbox_setup();
+
+	outbox_put(NRF_CLOUD_TOPIC_BULK, "m0");
+	outbox_put(NRF_CLOUD_TOPIC_BULK, "m1");
+	outbox_put(NRF_CLOUD_TOPIC_BULK, "m2");
+
+	publish_fail_at = 1;
+	TEST_ASSERT_EQUAL(-EIO, nct_outbox_flush());
+	TEST_ASSERT_EQUAL(1, published_cnt);
+	TEST_ASSERT_TRUE(nct_outbox_pending());
+
+	(void)nrf_cloud_outbox_stats_get(&stats);
+	TEST_ASSERT_EQUAL(2, stats.queued_msgs);
+
+	TEST_ASSERT_EQUAL(0, nct_outbox_flush());
+	TEST_ASSERT_EQUAL(3, published_cnt);
+	assert_published(0, 'B', "m0");
+	assert_published(1, 'B', "m1");
+	assert_published(2, 'B', "m2");
+	TEST_ASSERT_FALSE(nct_outbox_pending());
+}
+
+/* Verify that stored messages are not queued again when the settings are loaded
+ * by other modules after the outbox has been initialized.
+ * Ignored when the outbox is not persistent
+ */
+void test_outbox_settings_reload(void)
+{
+#if defined(CONFIG_NRF_CLOUD_OUTBOX_PERSISTENT)
+	struct nrf_cloud_outbox_stats stats;
+
+	outbox_setup();
+	TEST_ASSERT_EQUAL(0, nct_outbox_init());
+
+	outbox_put(NRF_CLOUD_TOPIC_BULK, "m0");
+	outbox_put(NRF_CLOUD_TOPIC_BULK, "m1");
+
+	/* Settings loads done by the transport and by DFU target stream */
+	TEST_ASSERT_EQUAL(0, settings_load_subtree(NRF_CLOUD_SETTINGS_NAME));
+	TEST_ASSERT_EQUAL(0, settings_load());
+
+	(void)nrf_cloud_outbox_stats_get(&stats);
+	TEST_ASSERT_EQUAL_MESSAGE(2, stats.queued_msgs,
+		"stored messages should not be queued again by a settings load");
+
+	TEST_ASSERT_EQUAL(0, nct_outbox_flush());
+	TEST_ASSERT_EQUAL(2, published_cnt);
+	assert_published(0, 'B', "m0");
+	assert_published(1, 'B', "m1");
+	TEST_ASSERT_FALSE(nct_outbox_pending());
+#else
+	TEST_IGNORE();
+#endif
+}
+
 void main(void)
 {
 	(void)unity_main();
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <string.h>
+#include <zephyr/settings/settings.h>
+
+/* Settings back-end that keeps the records in RAM */
+#define SETTINGS_MOCK_RECORDS	16
+#define SETTINGS_MOCK_NAME_LEN	32
+#define SETTINGS_MOCK_VAL_LEN	160
+
+static struct {
+	char name[SETTINGS_MOCK_NAME_LEN];
+	char val[SETTINGS_MOCK_VAL_LEN];
+	size_t val_len;
+} records[SETTINGS_MOCK_RECORDS];
+
+static ssize_t settings_mock_read_fn(void *back_end, void *data, size_t len)
+{
+	size_t idx = (size_t)back_end;
+
+	len = MIN(len, records[idx].val_len);
+	memcpy(data, records[idx].val, len);
+
+	return len;
+}
+
+static int settings_mock_load(struct settings_store *cs, const struct settings_load_arg *arg)
+{
+	int err;
+
+	for (size_t i = 0; i < ARRAY_SIZE(records); i++) {
+		if (records[i].name[0] == '\0') {
+			continue;
+		}
+
+		/* Records outside of arg->subtree are skipped by the set handler call */
+		err = settings_call_set_handler(records[i].name, records[i].val_len,
+						settings_mock_read_fn, (void *)i, arg);
+		if (err) {
+			return err;
+		}
+	}
+
+	return 0;
+}
+
+static int settings_mock_save(struct settings_store *cs, const char *name, const char *value,
+			      size_t val_len)
+{
+	int free_idx = -1;
+
+	if ((strlen(name) >= SETTINGS_MOCK_NAME_LEN) || (val_len > SETTINGS_MOCK_VAL_LEN)) {
+		return -ENOMEM;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(records); i++) {
+		if (!strcmp(records[i].name, name)) {
+			free_idx = i;
+			break;
+		}
+		if ((free_idx < 0) && (records[i].name[0] == '\0')) {
+			free_idx = i;
+		}
+	}
+
+	if (free_idx < 0) {
+		return -ENOMEM;
+	}
+
+	/* A zero length value deletes the record */
+	if (!value || !val_len) {
+		if (!strcmp(records[free_idx].name, name)) {
+			records[free_idx].name[0] = '\0';
+		}
+		return 0;
+	}
+
+	strcpy(records[free_idx].name, name);
+	memcpy(records[free_idx].val, value, val_len);
+	records[free_idx].val_len = val_len;
+
+	return 0;
+}
+
+static struct settings_store_itf settings_mock_itf = {
+	.csi_load = settings_mock_load,
+	.csi_save = settings_mock_save,
+};
+
+static struct settings_store settings_mock_store = {
+	.cs_itf = &settings_mock_itf
+};
+
+static int settings_mock_init(const struct device *unused)
+{
+	ARG_UNUSED(unused);
+
+	settings_dst_register(&settings_mock_store);
+	settings_src_register(&settings_mock_store);
+
+	return 0;
+}
+
+SYS_INIT(settings_mock_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEVICE);
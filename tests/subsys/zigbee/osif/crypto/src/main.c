@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 
+#include <string.h>
 #include <zephyr/ztest.h>
 #include <zephyr/logging/log.h>
 #include <zb_nrf_crypto.h>
@@ -14,6 +15,9 @@ LOG_MODULE_REGISTER(zboss_osif, CONFIG_ZBOSS_OSIF_LOG_LEVEL);
 #define AES_KEY_LENGTH       16
 #define AES_PLAINTEXT_LENGTH 16
 
+/* CCM* of a maximum size IEEE 802.15.4 frame takes about 16 AES blocks. */
+#define AES_FRAME_BLOCK_CNT  16
+
 /* AES test values (taken from FIPS-197) */
 uint8_t aes_key[AES_KEY_LENGTH] = {
 	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
@@ -43,10 +47,42 @@ static void test_crypto(void)
 	}
 }
 
+static void test_crypto_frame_benchmark(void)
+{
+	uint8_t plaintext[AES_FRAME_BLOCK_CNT * AES_PLAINTEXT_LENGTH];
+	uint8_t aes_encrypted[AES_FRAME_BLOCK_CNT * AES_PLAINTEXT_LENGTH] = {};
+	uint32_t start;
+	uint32_t cycles;
+
+	for (int i = 0; i < AES_FRAME_BLOCK_CNT; i++) {
+		memcpy(&plaintext[i * AES_PLAINTEXT_LENGTH], aes_plaintext,
+		       AES_PLAINTEXT_LENGTH);
+	}
+
+	zb_osif_aes_init();
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < AES_FRAME_BLOCK_CNT; i++) {
+		zb_osif_aes128_hw_encrypt(aes_key, &plaintext[i * AES_PLAINTEXT_LENGTH],
+					  &aes_encrypted[i * AES_PLAINTEXT_LENGTH]);
+	}
+	cycles = k_cycle_get_32() - start;
+
+	printk("AES blocks per frame: %d, cycles per frame: %u, cycles per block: %u\n",
+	       AES_FRAME_BLOCK_CNT, cycles, cycles / AES_FRAME_BLOCK_CNT);
+
+	for (int i = 0; i < AES_FRAME_BLOCK_CNT; i++) {
+		zassert_mem_equal(&aes_encrypted[i * AES_PLAINTEXT_LENGTH],
+				  aes_ciphertext, AES_PLAINTEXT_LENGTH,
+				  "Encrypted data mismatch in block %d", i);
+	}
+}
+
 void test_main(void)
 {
 	ztest_test_suite(nrf_osif_crypto_tests,
-			ztest_unit_test(test_crypto)
+			ztest_unit_test(test_crypto),
+			ztest_unit_test(test_crypto_frame_benchmark)
 	);
 
 	ztest_run_test_suite(nrf_osif_crypto_tests);